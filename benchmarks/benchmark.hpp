@@ -0,0 +1,133 @@
+#ifndef CUSTOMADS_SRC_BENCHMARKS_BENCHMARK_HPP_
+#define CUSTOMADS_SRC_BENCHMARKS_BENCHMARK_HPP_
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ads {
+
+// Keeps value alive, so the compiler can not drop the code computing it
+template <typename T>
+void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Best wall time of repeats_count calls of func in milliseconds
+template <typename Func>
+[[nodiscard]] double bestTimeMs(const std::size_t& repeats_count,
+                                Func&& func) {
+  double best_time = std::numeric_limits<double>::max();
+  for (std::size_t repeat = 0; repeat < repeats_count; ++repeat) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const std::chrono::duration<double, std::milli> time =
+        std::chrono::steady_clock::now() - start;
+    best_time = std::min(best_time, time.count());
+  }
+  return best_time;
+}
+
+// 1, 2, 4, ... threads up to the number given as the first argument or up
+// to the number of cores, which is included even if it is not a power of 2
+[[nodiscard]] inline std::vector<std::size_t> threadsCounts(int argc,
+                                                            char* argv[]) {
+  std::size_t max_threads_count =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10)
+                 : std::thread::hardware_concurrency();
+  max_threads_count = std::max<std::size_t>(max_threads_count, 1);
+  std::vector<std::size_t> threads_counts;
+  for (std::size_t threads_count = 1; threads_count < max_threads_count;
+       threads_count *= 2) {
+    threads_counts.push_back(threads_count);
+  }
+  threads_counts.push_back(max_threads_count);
+  return threads_counts;
+}
+
+// Random string of size symbols from [alpha_left, alpha_right]
+template <typename Generator>
+[[nodiscard]] std::string randomString(Generator& gen, const std::size_t& size,
+                                       const char& alpha_left,
+                                       const char& alpha_right) {
+  std::uniform_int_distribution<int> symbol_dist(alpha_left, alpha_right);
+  std::string result(size, alpha_left);
+  for (char& symbol : result) {
+    symbol = static_cast<char>(symbol_dist(gen));
+  }
+  return result;
+}
+
+// Resident memory of the process in MiB
+[[nodiscard]] inline double residentMemoryMib() {
+  std::ifstream statm("/proc/self/statm");
+  std::size_t total_pages = 0;
+  std::size_t resident_pages = 0;
+  statm >> total_pages >> resident_pages;
+  return static_cast<double>(resident_pages) *
+         static_cast<double>(::sysconf(_SC_PAGESIZE)) /
+         static_cast<double>(1ULL << 20);
+}
+
+struct TreeMeasurement {
+  double build_time_ms_;
+  double memory_mib_;
+  double query_time_ns_;
+  double update_time_ns_;
+};
+
+// Builds Tree over vec, then times segmentQuery over random segments and
+// indexUpdate at random indices if Tree has it, update_time_ns_ stays 0
+// otherwise. The same seed gives the same operations to every tree
+template <typename Tree, typename T>
+[[nodiscard]] TreeMeasurement measureTree(const std::vector<T>& vec,
+                                          const std::size_t& operations_count,
+                                          const unsigned int& seed) {
+  TreeMeasurement measurement{};
+  // Memory freed by the previous trees may stay resident and be reused
+  ::malloc_trim(0);
+  const double start_memory = residentMemoryMib();
+  std::unique_ptr<Tree> tree;
+  measurement.build_time_ms_ =
+      bestTimeMs(1, [&] { tree = std::make_unique<Tree>(vec); });
+  measurement.memory_mib_ = residentMemoryMib() - start_memory;
+  std::mt19937 gen(seed);
+  std::vector<std::size_t> indices(2 * operations_count);
+  for (std::size_t& index : indices) {
+    index = gen() % vec.size();
+  }
+  const double query_time = bestTimeMs(1, [&] {
+    for (std::size_t i = 0; i < operations_count; ++i) {
+      doNotOptimize(tree->segmentQuery(
+          std::min(indices[2 * i], indices[2 * i + 1]),
+          std::max(indices[2 * i], indices[2 * i + 1])));
+    }
+  });
+  const auto operations = static_cast<double>(operations_count);
+  measurement.query_time_ns_ = query_time * 1e6 / operations;
+  if constexpr (requires { tree->indexUpdate(indices[0], vec[0]); }) {
+    const double update_time = bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < operations_count; ++i) {
+        tree->indexUpdate(indices[i], static_cast<T>(indices[i] % 1000));
+      }
+      doNotOptimize(tree->segmentQuery(0, vec.size() - 1));
+    });
+    measurement.update_time_ns_ = update_time * 1e6 / operations;
+  }
+  return measurement;
+}
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_BENCHMARKS_BENCHMARK_HPP_
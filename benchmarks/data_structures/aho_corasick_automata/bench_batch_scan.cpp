@@ -0,0 +1,53 @@
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+
+// findAllOccurrences(text) called for every text against one
+// findAllOccurrences(texts) call. Every text holds prefixes of four
+// patterns, so the scan goes deep into the trie of a large dictionary
+int main() {
+  constexpr std::size_t kTextsCount = 100'000;
+  constexpr std::size_t kPlantedCount = 4;
+  constexpr std::size_t kRepeatsCount = 3;
+  std::mt19937 gen(27);
+  std::printf("%zu texts of 64-255 letters, best of %zu runs\n", kTextsCount,
+              kRepeatsCount);
+  std::printf("%10s %10s %10s %8s\n", "patterns", "loop, ms", "batch, ms",
+              "speedup");
+  for (const std::size_t patterns_count : {1'000ULL, 100'000ULL, 500'000ULL}) {
+    ads::AhoCorasickAutomata<'a', 'z'> automata;
+    std::vector<std::string> patterns;
+    for (std::size_t i = 0; i < patterns_count; ++i) {
+      patterns.push_back(ads::randomString(gen, 8 + gen() % 24, 'a', 'z'));
+      automata.addString(patterns.back());
+    }
+    std::vector<std::string> texts;
+    for (std::size_t i = 0; i < kTextsCount; ++i) {
+      std::string text = ads::randomString(gen, 64 + gen() % 192, 'a', 'z');
+      for (std::size_t planted = 0; planted < kPlantedCount; ++planted) {
+        const std::string& pattern = patterns[gen() % patterns.size()];
+        text.replace(gen() % (text.size() - pattern.size()),
+                     pattern.size() - 1, pattern, 0, pattern.size() - 1);
+      }
+      texts.push_back(std::move(text));
+    }
+    ads::doNotOptimize(automata.findAllOccurrences(texts[0]).size());
+    const double loop_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      for (const std::string& text : texts) {
+        ads::doNotOptimize(automata.findAllOccurrences(text).size());
+      }
+    });
+    const double batch_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      ads::doNotOptimize(automata.findAllOccurrences(texts).size());
+    });
+    std::printf("%10zu %10.0f %10.0f %8.2f\n", patterns_count, loop_time,
+                batch_time, loop_time / batch_time);
+  }
+  return 0;
+}
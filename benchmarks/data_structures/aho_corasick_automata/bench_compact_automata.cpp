@@ -0,0 +1,75 @@
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+#include "data_structures/aho_corasick_automata/compact_aho_corasick_automata.hpp"
+
+namespace {
+
+// Peak resident memory of the process in MiB
+double peakMemoryMib() {
+  rusage usage{};
+  ::getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) / 1024.0;
+}
+
+// Runs in a child process, so that the peak memory of every automaton is
+// measured separately
+template <typename Automata>
+void runInChild(const char* mode_name, const std::size_t& patterns_count,
+                const std::string& text) {
+  std::fflush(stdout);
+  const pid_t pid = ::fork();
+  if (pid != 0) {
+    ::waitpid(pid, nullptr, 0);
+    return;
+  }
+  const double start_memory = peakMemoryMib();
+  std::mt19937 gen(29);
+  Automata automata;
+  const double build_time = ads::bestTimeMs(1, [&] {
+    for (std::size_t i = 0; i < patterns_count; ++i) {
+      automata.addString(ads::randomString(gen, 6 + gen() % 7, 'a', 'z'));
+    }
+    ads::doNotOptimize(automata.findAllOccurrences("a").size());
+  });
+  const double memory = peakMemoryMib() - start_memory;
+  const double scan_time = ads::bestTimeMs(2, [&] {
+    ads::doNotOptimize(automata.findAllOccurrences(text).size());
+  });
+  std::printf("%10zu %8s %10.0f %12.0f %12.0f\n", patterns_count, mode_name,
+              build_time, memory, scan_time);
+  std::fflush(stdout);
+  std::_Exit(0);
+}
+
+}  // namespace
+
+// Dense AhoCorasickAutomata against CompactAhoCorasickAutomata, patterns of
+// 6-12 random letters. Usage: bench_compact_automata [max patterns count,
+// default: 10^6], the dense automaton of 10^7 patterns needs about 20 GiB
+int main(int argc, char* argv[]) {
+  const std::size_t max_patterns_count =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+  std::mt19937 gen(290);
+  const std::string text = ads::randomString(gen, 1ULL << 23, 'a', 'z');
+  std::printf("scan of 8 MiB of random text, memory is the peak growth\n");
+  std::printf("%10s %8s %10s %12s %12s\n", "patterns", "mode", "build, ms",
+              "memory, MiB", "scan, ms");
+  for (std::size_t patterns_count = 1'000;
+       patterns_count <= max_patterns_count; patterns_count *= 10) {
+    runInChild<ads::AhoCorasickAutomata<'a', 'z'>>("dense", patterns_count,
+                                                   text);
+    runInChild<ads::CompactAhoCorasickAutomata<'a', 'z'>>(
+        "compact", patterns_count, text);
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+
+// Latency of addString followed by a search of 1 KiB of text on a built
+// automaton, against a full build of the dictionary. Usage:
+// bench_incremental_update [patterns count, default: 10^5]
+// [updates count, default: 10^4]
+int main(int argc, char* argv[]) {
+  const std::size_t patterns_count =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+  const std::size_t updates_count =
+      (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10'000;
+  std::mt19937 gen(31);
+  std::vector<std::string> patterns;
+  for (std::size_t i = 0; i < patterns_count + updates_count; ++i) {
+    patterns.push_back(ads::randomString(gen, 6 + gen() % 7, 'a', 'z'));
+  }
+  const std::string text = ads::randomString(gen, 1024, 'a', 'z');
+  ads::AhoCorasickAutomata<'a', 'z'> automata;
+  const double build_time = ads::bestTimeMs(1, [&] {
+    for (std::size_t i = 0; i < patterns_count; ++i) {
+      automata.addString(patterns[i]);
+    }
+    ads::doNotOptimize(automata.findAllOccurrences(text).size());
+  });
+  std::vector<double> latencies;
+  latencies.reserve(updates_count);
+  for (std::size_t i = 0; i < updates_count; ++i) {
+    latencies.push_back(ads::bestTimeMs(1, [&] {
+      automata.addString(patterns[patterns_count + i]);
+      ads::doNotOptimize(automata.findAllOccurrences(text).size());
+    }));
+  }
+  double total_time = 0;
+  for (const double latency : latencies) {
+    total_time += latency;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%zu patterns of 6-12 letters, %zu updates\n", patterns_count,
+              updates_count);
+  std::printf("full build: %.0f ms\n", build_time);
+  std::printf("addString + search, ms: mean %.3f, p50 %.3f, p99 %.3f, max "
+              "%.1f\n",
+              total_time / static_cast<double>(latencies.size()),
+              latencies[latencies.size() / 2],
+              latencies[latencies.size() * 99 / 100], latencies.back());
+  return 0;
+}
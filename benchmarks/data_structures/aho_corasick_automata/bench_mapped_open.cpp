@@ -0,0 +1,56 @@
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+#include "data_structures/aho_corasick_automata/mapped_aho_corasick_automata.hpp"
+
+// Building a large automaton against opening its saved file with every
+// AhoCorasickFileCheck. The pages of the file are in the page cache, as
+// for a worker process started next to others which mapped it
+int main() {
+  constexpr std::size_t kPatternsCount = 500'000;
+  constexpr std::size_t kRepeatsCount = 5;
+  std::mt19937 gen(28);
+  const std::string file_path =
+      (std::filesystem::temp_directory_path() / "bench_mapped_open.bin")
+          .string();
+  const std::string text = ads::randomString(gen, 1ULL << 20, 'a', 'z');
+  const double build_time = ads::bestTimeMs(1, [&] {
+    ads::AhoCorasickAutomata<'a', 'z'> automata;
+    for (std::size_t i = 0; i < kPatternsCount; ++i) {
+      automata.addString(ads::randomString(gen, 8 + gen() % 8, 'a', 'z'));
+    }
+    ads::doNotOptimize(automata.findAllOccurrences(text).size());
+    automata.saveToFile(file_path);
+  });
+  std::printf("%zu patterns of 8-15 letters, file of %.0f MiB\n",
+              kPatternsCount,
+              static_cast<double>(std::filesystem::file_size(file_path)) /
+                  static_cast<double>(1ULL << 20));
+  std::printf("build and save: %.0f ms\n", build_time);
+  std::printf("%10s %10s %16s\n", "check", "open, ms", "open+scan 1 MiB");
+  const std::pair<const char*, ads::AhoCorasickFileCheck> checks[] = {
+      {"trusted", ads::AhoCorasickFileCheck::kTrusted},
+      {"structure", ads::AhoCorasickFileCheck::kStructure},
+      {"checksum", ads::AhoCorasickFileCheck::kChecksum}};
+  for (const auto& [check_name, check] : checks) {
+    const double open_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      const ads::MappedAhoCorasickAutomata<'a', 'z'> automata(file_path,
+                                                              check);
+      ads::doNotOptimize(automata);
+    });
+    const double scan_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      const ads::MappedAhoCorasickAutomata<'a', 'z'> automata(file_path,
+                                                              check);
+      ads::doNotOptimize(automata.findAllOccurrences(text).size());
+    });
+    std::printf("%10s %10.3f %16.1f\n", check_name, open_time, scan_time);
+  }
+  std::filesystem::remove(file_path);
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+
+// findAllOccurrences against findAllOccurrencesParallel on random text.
+// Usage: bench_parallel_scan [max threads count, default: cores count]
+int main(int argc, char* argv[]) {
+  constexpr std::size_t kPatternsCount = 1000;
+  constexpr std::size_t kRepeatsCount = 3;
+  const std::vector<std::size_t> threads_counts =
+      ads::threadsCounts(argc, argv);
+  std::mt19937 gen(26);
+  ads::AhoCorasickAutomata<'a', 'z'> automata;
+  for (std::size_t i = 0; i < kPatternsCount; ++i) {
+    automata.addString(ads::randomString(gen, 4 + i % 8, 'a', 'z'));
+  }
+  std::printf("%zu patterns of 4-11 letters, best of %zu runs\n",
+              kPatternsCount, kRepeatsCount);
+  std::printf("%11s %8s %10s %10s %8s\n", "text", "threads", "time, ms",
+              "MiB/s", "speedup");
+  for (const std::size_t text_size : {1ULL << 20, 1ULL << 26}) {
+    const std::string text = ads::randomString(gen, text_size, 'a', 'z');
+    const double serial_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      ads::doNotOptimize(automata.findAllOccurrences(text).size());
+    });
+    const double text_mib =
+        static_cast<double>(text_size) / static_cast<double>(1ULL << 20);
+    std::printf("%7.0f MiB %8s %10.1f %10.0f %8.2f\n", text_mib, "serial",
+                serial_time, text_mib * 1000.0 / serial_time, 1.0);
+    for (const std::size_t threads_count : threads_counts) {
+      const double time = ads::bestTimeMs(kRepeatsCount, [&] {
+        ads::doNotOptimize(
+            automata.findAllOccurrencesParallel(text, threads_count).size());
+      });
+      std::printf("%7.0f MiB %8zu %10.1f %10.0f %8.2f\n", text_mib,
+                  threads_count, time, text_mib * 1000.0 / time,
+                  serial_time / time);
+    }
+  }
+  return 0;
+}
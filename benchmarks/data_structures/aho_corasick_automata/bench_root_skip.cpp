@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "benchmark.hpp"
+#include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+
+// Scan of low match density text: patterns start with 'x'-'z', the text is
+// made of 'a'-'w' with the given share of 'x'-'z'. With no start symbols
+// the scan is the root skip alone, with every symbol a start symbol it is
+// the plain transition loop
+int main() {
+  constexpr std::size_t kPatternsCount = 1000;
+  constexpr std::size_t kTextSize = 1ULL << 26;
+  constexpr std::size_t kRepeatsCount = 3;
+  std::mt19937 gen(30);
+  ads::AhoCorasickAutomata<'a', 'z'> automata;
+  for (std::size_t i = 0; i < kPatternsCount; ++i) {
+    std::string pattern = ads::randomString(gen, 8, 'a', 'z');
+    pattern[0] = static_cast<char>('x' + i % 3);
+    automata.addString(pattern);
+  }
+  std::printf("64 MiB of text, %zu patterns of 8 letters, best of %zu runs\n",
+              kPatternsCount, kRepeatsCount);
+  std::printf("%14s %10s %10s\n", "start symbols", "time, ms", "MiB/s");
+  for (const std::size_t per_mille : {0ULL, 1ULL, 10ULL, 100ULL, 1000ULL}) {
+    std::string text = ads::randomString(gen, kTextSize, 'a', 'w');
+    for (char& symbol : text) {
+      if (gen() % 1000 < per_mille) {
+        symbol = static_cast<char>('x' + gen() % 3);
+      }
+    }
+    const double time = ads::bestTimeMs(kRepeatsCount, [&] {
+      ads::doNotOptimize(automata.findAllOccurrences(text).size());
+    });
+    std::printf("%13.1f%% %10.0f %10.0f\n",
+                static_cast<double>(per_mille) / 10.0, time,
+                static_cast<double>(kTextSize >> 20) * 1000.0 / time);
+  }
+  return 0;
+}
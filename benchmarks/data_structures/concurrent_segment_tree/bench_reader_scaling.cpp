@@ -0,0 +1,125 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/concurrent_segment_tree/concurrent_segment_tree.hpp"
+#include "data_structures/iterative_segment_tree/iterative_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+
+namespace {
+
+constexpr std::size_t kSize = 1'000'000;
+// The writer does kUpdatesPerTick updates every millisecond
+constexpr std::size_t kUpdatesPerTick = 100;
+constexpr auto kDuration = std::chrono::milliseconds(500);
+
+struct ScalingMeasurement {
+  double queries_per_second_;
+  double updates_per_second_;
+};
+
+// readers_count threads call query over random segments while one thread
+// calls update at a constant rate for kDuration
+template <typename Query, typename Update>
+[[nodiscard]] ScalingMeasurement measureScaling(
+    const std::size_t& readers_count, const Query& query,
+    const Update& update) {
+  std::atomic<bool> is_running = true;
+  std::atomic<std::size_t> queries_count = 0;
+  std::vector<std::thread> readers;
+  for (std::size_t reader_ind = 0; reader_ind < readers_count; ++reader_ind) {
+    readers.emplace_back([&, reader_ind] {
+      std::mt19937 gen(static_cast<unsigned int>(440 + reader_ind));
+      std::size_t reader_queries_count = 0;
+      while (is_running.load(std::memory_order_relaxed)) {
+        std::size_t left = gen() % kSize;
+        std::size_t right = gen() % kSize;
+        if (left > right) {
+          std::swap(left, right);
+        }
+        ads::doNotOptimize(query(left, right));
+        ++reader_queries_count;
+      }
+      queries_count += reader_queries_count;
+    });
+  }
+  std::mt19937 gen(44);
+  std::size_t updates_count = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto tick = start; tick - start < kDuration;
+       tick += std::chrono::milliseconds(1)) {
+    for (std::size_t i = 0; i < kUpdatesPerTick; ++i) {
+      update(gen() % kSize, static_cast<std::int64_t>(gen() % 1000));
+    }
+    updates_count += kUpdatesPerTick;
+    std::this_thread::sleep_until(tick + std::chrono::milliseconds(1));
+  }
+  is_running.store(false);
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  const std::chrono::duration<double> time =
+      std::chrono::steady_clock::now() - start;
+  return {static_cast<double>(queries_count.load()) / time.count(),
+          static_cast<double>(updates_count) / time.count()};
+}
+
+}  // namespace
+
+// ConcurrentSegmentTree against IterativeSegmentTree behind a
+// std::shared_mutex, int64 sums, 1, 2, 4, ... readers and one writer doing
+// 10^5 updates per second. Usage: bench_reader_scaling [max readers count]
+int main(int argc, char* argv[]) {
+  using Sum = ads::Sum<std::int64_t>;
+  std::mt19937 gen(44);
+  std::vector<std::int64_t> vec(kSize);
+  for (std::int64_t& value : vec) {
+    value = static_cast<std::int64_t>(gen() % 1000);
+  }
+  ads::ConcurrentSegmentTree<std::int64_t, Sum, 0> concurrent_tree(vec);
+  ads::IterativeSegmentTree<std::int64_t, Sum, 0> locked_tree(vec);
+  std::shared_mutex mutex;
+  std::printf("%zu int64 sums, one writer, %.0f ms per row\n", kSize,
+              std::chrono::duration<double, std::milli>(kDuration).count());
+  std::printf("%8s %14s %16s %16s\n", "readers", "tree", "queries per s",
+              "updates per s");
+  const auto print = [](const std::size_t& readers_count,
+                        const char* tree_name,
+                        const ScalingMeasurement& measurement) {
+    std::printf("%8zu %14s %16.0f %16.0f\n", readers_count, tree_name,
+                measurement.queries_per_second_,
+                measurement.updates_per_second_);
+  };
+  for (const std::size_t readers_count : ads::threadsCounts(argc, argv)) {
+    print(readers_count, "Concurrent",
+          measureScaling(
+              readers_count,
+              [&](const std::size_t& left, const std::size_t& right) {
+                return concurrent_tree.segmentQuery(left, right);
+              },
+              [&](const std::size_t& index, const std::int64_t& value) {
+                concurrent_tree.indexUpdate(index, value);
+              }));
+    print(readers_count, "shared_mutex",
+          measureScaling(
+              readers_count,
+              [&](const std::size_t& left, const std::size_t& right) {
+                const std::shared_lock<std::shared_mutex> lock(mutex);
+                return locked_tree.segmentQuery(left, right);
+              },
+              [&](const std::size_t& index, const std::int64_t& value) {
+                const std::unique_lock<std::shared_mutex> lock(mutex);
+                locked_tree.indexUpdate(index, value);
+              }));
+  }
+  return 0;
+}
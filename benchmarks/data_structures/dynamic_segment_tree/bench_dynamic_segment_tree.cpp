@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/dynamic_segment_tree/dynamic_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+
+// DynamicSegmentTree of int64 sums over [0, 2^bits - 1] with updates at
+// random indices, std::map insertion of the same keys is the reference
+int main() {
+  constexpr std::size_t kOperationsCount = 1'000'000;
+  using Sum = ads::Sum<std::int64_t>;
+  std::printf("%zu updates and queries, times per operation\n",
+              kOperationsCount);
+  std::printf("%5s %11s %15s %17s %10s\n", "bits", "update, ns",
+              "map insert, ns", "nodes per update", "query, ns");
+  for (const std::uint32_t bits : {20U, 40U, 64U}) {
+    const std::uint64_t max_index =
+        (bits == 64) ? std::numeric_limits<std::uint64_t>::max()
+                     : (std::uint64_t{1} << bits) - 1;
+    std::mt19937_64 gen(40);
+    std::vector<std::uint64_t> indices(kOperationsCount);
+    for (std::uint64_t& index : indices) {
+      index = (bits == 64) ? gen() : gen() % (max_index + 1);
+    }
+    ads::DynamicSegmentTree<std::int64_t, Sum, 0> tree(max_index);
+    const double update_time = ads::bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < kOperationsCount; ++i) {
+        tree.indexUpdate(indices[i], static_cast<std::int64_t>(i % 1000));
+      }
+    });
+    std::map<std::uint64_t, std::int64_t> map;
+    const double map_time = ads::bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < kOperationsCount; ++i) {
+        map[indices[i]] = static_cast<std::int64_t>(i % 1000);
+      }
+    });
+    std::vector<std::uint64_t> query_indices(2 * kOperationsCount);
+    for (std::uint64_t& index : query_indices) {
+      index = indices[gen() % kOperationsCount];
+    }
+    const double query_time = ads::bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < kOperationsCount; ++i) {
+        ads::doNotOptimize(tree.segmentQuery(
+            std::min(query_indices[2 * i], query_indices[2 * i + 1]),
+            std::max(query_indices[2 * i], query_indices[2 * i + 1])));
+      }
+    });
+    const auto operations = static_cast<double>(kOperationsCount);
+    std::printf("%5u %11.0f %15.0f %17.1f %10.0f\n", bits,
+                update_time * 1e6 / operations, map_time * 1e6 / operations,
+                static_cast<double>(tree.nodesCount()) / operations,
+                query_time * 1e6 / operations);
+  }
+  return 0;
+}
@@ -0,0 +1,42 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/fenwick_tree/fenwick_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+
+// FenwickTree against SegmentTree, int64 sums
+int main() {
+  constexpr std::size_t kOperationsCount = 1'000'000;
+  using Sum = ads::Sum<std::int64_t>;
+  std::printf("%zu queries and updates, times per operation\n",
+              kOperationsCount);
+  std::printf("%10s %12s %10s %12s %10s %10s\n", "size", "tree",
+              "build, ms", "memory, MiB", "query, ns", "update, ns");
+  for (const std::size_t size : {10'000ULL, 1'000'000ULL, 10'000'000ULL}) {
+    std::mt19937 gen(36);
+    std::vector<std::int64_t> vec(size);
+    for (std::int64_t& value : vec) {
+      value = static_cast<std::int64_t>(gen() % 1000);
+    }
+    const auto print = [size](const char* tree_name,
+                              const ads::TreeMeasurement& measurement) {
+      std::printf("%10zu %12s %10.1f %12.1f %10.0f %10.0f\n", size, tree_name,
+                  measurement.build_time_ms_, measurement.memory_mib_,
+                  measurement.query_time_ns_, measurement.update_time_ns_);
+    };
+    print("SegmentTree",
+          ads::measureTree<ads::SegmentTree<std::int64_t, Sum, 0>>(
+              vec, kOperationsCount, 360));
+    print("FenwickTree",
+          ads::measureTree<ads::FenwickTree<std::int64_t, Sum, 0,
+                                            std::minus<std::int64_t>>>(
+              vec, kOperationsCount, 360));
+  }
+  return 0;
+}
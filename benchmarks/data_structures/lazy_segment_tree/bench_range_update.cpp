@@ -0,0 +1,91 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/lazy_segment_tree/lazy_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+
+namespace {
+
+struct AddToSum {
+  std::int64_t operator()(const std::int64_t& value, const std::int64_t& tag,
+                          const std::size_t size) const noexcept {
+    return value + tag * static_cast<std::int64_t>(size);
+  }
+
+  std::int64_t compose(const std::int64_t& first,
+                       const std::int64_t& second) const noexcept {
+    return first + second;
+  }
+
+  std::int64_t repeat(const std::int64_t& value,
+                      const std::size_t size) const noexcept {
+    return value * static_cast<std::int64_t>(size);
+  }
+};
+
+}  // namespace
+
+// rangeAssign and rangeApply of LazySegmentTree against an indexUpdate loop
+// over SegmentTree. Every update of the given length is followed by a query
+// over half of its segment
+int main() {
+  constexpr std::size_t kSize = 1'000'000;
+  constexpr std::size_t kUpdatesCount = 2000;
+  std::mt19937 gen(33);
+  std::vector<std::int64_t> vec(kSize);
+  for (std::int64_t& value : vec) {
+    value = static_cast<std::int64_t>(gen() % 1000);
+  }
+  std::printf("%zu int64 sums, %zu updates of each length\n", kSize,
+              kUpdatesCount);
+  std::printf("%8s %15s %10s %14s %10s\n", "length", "rangeAssign, ms",
+              "loop, ms", "rangeApply, ms", "loop, ms");
+  for (const std::size_t length : {16ULL, 1024ULL, 65536ULL}) {
+    std::vector<std::size_t> lefts(kUpdatesCount);
+    for (std::size_t& left : lefts) {
+      left = gen() % (kSize - length + 1);
+    }
+    ads::LazySegmentTree<std::int64_t, ads::Sum<std::int64_t>, 0,
+                         std::int64_t, AddToSum>
+        lazy_tree(vec);
+    ads::SegmentTree<std::int64_t, ads::Sum<std::int64_t>, 0> tree(vec);
+    std::vector<std::int64_t> values = vec;
+    const double assign_time = ads::bestTimeMs(1, [&] {
+      for (const std::size_t left : lefts) {
+        lazy_tree.rangeAssign(left, left + length - 1, 7);
+        ads::doNotOptimize(lazy_tree.segmentQuery(left, left + length / 2));
+      }
+    });
+    const double assign_loop_time = ads::bestTimeMs(1, [&] {
+      for (const std::size_t left : lefts) {
+        for (std::size_t index = left; index < left + length; ++index) {
+          tree.indexUpdate(index, 7);
+        }
+        ads::doNotOptimize(tree.segmentQuery(left, left + length / 2));
+      }
+    });
+    const double apply_time = ads::bestTimeMs(1, [&] {
+      for (const std::size_t left : lefts) {
+        lazy_tree.rangeApply(left, left + length - 1, 3);
+        ads::doNotOptimize(lazy_tree.segmentQuery(left, left + length / 2));
+      }
+    });
+    const double apply_loop_time = ads::bestTimeMs(1, [&] {
+      for (const std::size_t left : lefts) {
+        for (std::size_t index = left; index < left + length; ++index) {
+          values[index] += 3;
+          tree.indexUpdate(index, values[index]);
+        }
+        ads::doNotOptimize(tree.segmentQuery(left, left + length / 2));
+      }
+    });
+    std::printf("%8zu %15.1f %10.1f %14.1f %10.1f\n", length, assign_time,
+                assign_loop_time, apply_time, apply_loop_time);
+  }
+  return 0;
+}
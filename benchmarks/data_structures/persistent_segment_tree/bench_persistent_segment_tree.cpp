@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/persistent_segment_tree/persistent_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+
+// PersistentSegmentTree of int64 sums: every update branches from a random
+// existing version, so the versions form a tree rather than a chain.
+// SegmentTree with the same operations on one version is the reference
+int main() {
+  constexpr std::size_t kSize = 1'000'000;
+  constexpr std::size_t kOperationsCount = 1'000'000;
+  constexpr std::size_t kKeptVersionsCount = 100;
+  using Sum = ads::Sum<std::int64_t>;
+  std::mt19937 gen(39);
+  std::vector<std::int64_t> vec(kSize);
+  for (std::int64_t& value : vec) {
+    value = static_cast<std::int64_t>(gen() % 1000);
+  }
+  std::vector<std::size_t> indices(2 * kOperationsCount);
+  for (std::size_t& index : indices) {
+    index = gen() % kSize;
+  }
+  std::vector<std::size_t> random_numbers(kOperationsCount);
+  for (std::size_t& random_number : random_numbers) {
+    random_number = gen();
+  }
+  std::size_t last_version = 0;
+  std::unique_ptr<ads::PersistentSegmentTree<std::int64_t, Sum, 0>> tree;
+  const double build_time = ads::bestTimeMs(1, [&] {
+    tree = std::make_unique<ads::PersistentSegmentTree<std::int64_t, Sum, 0>>(
+        vec);
+  });
+  const std::size_t base_nodes_count = tree->nodesCount();
+  const double update_time = ads::bestTimeMs(1, [&] {
+    for (std::size_t i = 0; i < kOperationsCount; ++i) {
+      last_version = tree->indexUpdate(random_numbers[i] % (last_version + 1),
+                                       indices[i],
+                                       static_cast<std::int64_t>(i % 1000));
+    }
+  });
+  const std::size_t nodes_count = tree->nodesCount();
+  const double query_time = ads::bestTimeMs(1, [&] {
+    for (std::size_t i = 0; i < kOperationsCount; ++i) {
+      ads::doNotOptimize(tree->segmentQuery(
+          random_numbers[i] % (last_version + 1),
+          std::min(indices[2 * i], indices[2 * i + 1]),
+          std::max(indices[2 * i], indices[2 * i + 1])));
+    }
+  });
+  std::vector<std::size_t> kept_versions;
+  for (std::size_t i = 0; i < kKeptVersionsCount; ++i) {
+    kept_versions.push_back(last_version - i * 1000);
+  }
+  const double compact_time =
+      ads::bestTimeMs(1, [&] { tree->compact(kept_versions); });
+  const ads::TreeMeasurement reference =
+      ads::measureTree<ads::SegmentTree<std::int64_t, Sum, 0>>(
+          vec, kOperationsCount, 390);
+  const auto operations = static_cast<double>(kOperationsCount);
+  std::printf("%zu int64 sums, %zu updates and queries\n", kSize,
+              kOperationsCount);
+  std::printf("build: %.0f ms, %zu nodes\n", build_time, base_nodes_count);
+  std::printf("indexUpdate: %.0f ns, %.1f nodes per version\n",
+              update_time * 1e6 / operations,
+              static_cast<double>(nodes_count - base_nodes_count) /
+                  operations);
+  std::printf("segmentQuery of a random version: %.0f ns\n",
+              query_time * 1e6 / operations);
+  std::printf("SegmentTree: indexUpdate %.0f ns, segmentQuery %.0f ns\n",
+              reference.update_time_ns_, reference.query_time_ns_);
+  std::printf("compact to %zu versions: %.0f ms, %zu -> %zu nodes\n",
+              kKeptVersionsCount, compact_time, nodes_count,
+              tree->nodesCount());
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+
+// SegmentTree::segmentQueries and applyUpdates against per-call loops over
+// 10^6 int64 sums. Usage: bench_batch_operations [max threads count]
+int main(int argc, char* argv[]) {
+  constexpr std::size_t kSize = 1'000'000;
+  constexpr std::size_t kRepeatsCount = 5;
+  using Tree = ads::SegmentTree<std::int64_t, ads::Sum<std::int64_t>, 0>;
+  std::mt19937 gen(41);
+  std::vector<std::int64_t> vec(kSize);
+  for (std::int64_t& value : vec) {
+    value = static_cast<std::int64_t>(gen() % 1000);
+  }
+  Tree tree(vec);
+  const std::vector<std::size_t> threads_counts =
+      ads::threadsCounts(argc, argv);
+  std::printf("%zu int64 sums, times per batch\n", kSize);
+  std::printf("%10s %8s %16s %16s %16s %16s\n", "batch", "threads",
+              "query loop, ms", "queries, ms", "update loop, ms",
+              "updates, ms");
+  for (const std::size_t batch_size : {1'000ULL, 100'000ULL, 1'000'000ULL}) {
+    std::vector<std::pair<std::size_t, std::size_t>> queries(batch_size);
+    for (auto& [left, right] : queries) {
+      left = gen() % kSize;
+      right = gen() % kSize;
+      if (left > right) {
+        std::swap(left, right);
+      }
+    }
+    std::vector<std::pair<std::size_t, std::int64_t>> updates(batch_size);
+    for (auto& [index, value] : updates) {
+      index = gen() % kSize;
+      value = static_cast<std::int64_t>(gen() % 1000);
+    }
+    std::vector<std::int64_t> answers(batch_size);
+    const double query_loop_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      for (std::size_t i = 0; i < batch_size; ++i) {
+        answers[i] = tree.segmentQuery(queries[i].first, queries[i].second);
+      }
+      ads::doNotOptimize(answers.data());
+    });
+    const double update_loop_time = ads::bestTimeMs(kRepeatsCount, [&] {
+      for (const auto& [index, value] : updates) {
+        tree.indexUpdate(index, value);
+      }
+      ads::doNotOptimize(tree.segmentQuery(0, kSize - 1));
+    });
+    for (const std::size_t threads_count : threads_counts) {
+      const double queries_time = ads::bestTimeMs(kRepeatsCount, [&] {
+        tree.segmentQueries(queries, answers, threads_count);
+        ads::doNotOptimize(answers.data());
+      });
+      const double updates_time = ads::bestTimeMs(kRepeatsCount, [&] {
+        tree.applyUpdates(updates, threads_count);
+        ads::doNotOptimize(tree.segmentQuery(0, kSize - 1));
+      });
+      std::printf("%10zu %8zu %16.3f %16.3f %16.3f %16.3f\n", batch_size,
+                  threads_count, query_loop_time, queries_time,
+                  update_loop_time, updates_time);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/iterative_segment_tree/iterative_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree_2d/segment_tree_2d.hpp"
+
+// SegmentTree2D against one IterativeSegmentTree per row, int64 sums over
+// square matrices. A rectangle query of the per-row approach asks every row
+// of the rectangle
+int main() {
+  constexpr std::size_t kOperationsCount = 200'000;
+  using Sum = ads::Sum<std::int64_t>;
+  std::printf("%zu queries and updates, times per operation\n",
+              kOperationsCount);
+  std::printf("%10s %12s %10s %10s %10s\n", "matrix", "structure",
+              "build, ms", "query, ns", "update, ns");
+  for (const std::size_t side : {256ULL, 1'024ULL, 4'096ULL}) {
+    std::mt19937 gen(43);
+    std::vector<std::vector<std::int64_t>> matrix(
+        side, std::vector<std::int64_t>(side));
+    for (std::vector<std::int64_t>& row : matrix) {
+      for (std::int64_t& value : row) {
+        value = static_cast<std::int64_t>(gen() % 1000);
+      }
+    }
+    // top, bottom, left, right
+    std::vector<std::array<std::size_t, 4>> rectangles(kOperationsCount);
+    for (std::array<std::size_t, 4>& rectangle : rectangles) {
+      for (std::size_t& index : rectangle) {
+        index = gen() % side;
+      }
+      std::sort(rectangle.begin(), rectangle.begin() + 2);
+      std::sort(rectangle.begin() + 2, rectangle.end());
+    }
+    const auto operations = static_cast<double>(kOperationsCount);
+    const auto print = [side, operations](const char* structure_name,
+                                          const double& build_time,
+                                          const double& query_time,
+                                          const double& update_time) {
+      std::printf("%4zux%-5zu %12s %10.1f %10.0f %10.0f\n", side, side,
+                  structure_name, build_time, query_time * 1e6 / operations,
+                  update_time * 1e6 / operations);
+    };
+    std::unique_ptr<ads::SegmentTree2D<std::int64_t, Sum, 0>> tree;
+    const double tree_build_time = ads::bestTimeMs(1, [&] {
+      tree = std::make_unique<ads::SegmentTree2D<std::int64_t, Sum, 0>>(
+          matrix);
+    });
+    const double tree_query_time = ads::bestTimeMs(1, [&] {
+      for (const auto& [top, bottom, left, right] : rectangles) {
+        ads::doNotOptimize(tree->rectangleQuery(top, bottom, left, right));
+      }
+    });
+    const double tree_update_time = ads::bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < kOperationsCount; ++i) {
+        tree->indexUpdate(rectangles[i][0], rectangles[i][2],
+                          static_cast<std::int64_t>(i % 1000));
+      }
+      ads::doNotOptimize(tree->rectangleQuery(0, side - 1, 0, side - 1));
+    });
+    print("2D", tree_build_time, tree_query_time, tree_update_time);
+    tree.reset();
+    std::vector<ads::IterativeSegmentTree<std::int64_t, Sum, 0>> rows;
+    const double rows_build_time = ads::bestTimeMs(1, [&] {
+      rows.reserve(side);
+      for (const std::vector<std::int64_t>& row : matrix) {
+        rows.emplace_back(row);
+      }
+    });
+    const double rows_query_time = ads::bestTimeMs(1, [&] {
+      for (const auto& [top, bottom, left, right] : rectangles) {
+        std::int64_t result = 0;
+        for (std::size_t row = top; row <= bottom; ++row) {
+          result += rows[row].segmentQuery(left, right);
+        }
+        ads::doNotOptimize(result);
+      }
+    });
+    const double rows_update_time = ads::bestTimeMs(1, [&] {
+      for (std::size_t i = 0; i < kOperationsCount; ++i) {
+        rows[rectangles[i][0]].indexUpdate(
+            rectangles[i][2], static_cast<std::int64_t>(i % 1000));
+      }
+      ads::doNotOptimize(rows[0].segmentQuery(0, side - 1));
+    });
+    print("per-row", rows_build_time, rows_query_time, rows_update_time);
+  }
+  return 0;
+}
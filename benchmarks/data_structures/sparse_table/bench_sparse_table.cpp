@@ -0,0 +1,48 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+#include "data_structures/sparse_table/disjoint_sparse_table.hpp"
+#include "data_structures/sparse_table/sparse_table.hpp"
+
+// SparseTable and DisjointSparseTable against SegmentTree, int32 minimums.
+// Usage: bench_sparse_table [queries count, default: 10^7]
+int main(int argc, char* argv[]) {
+  const std::size_t queries_count =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  using Min = ads::Min<std::int32_t>;
+  constexpr std::int32_t kMax = std::numeric_limits<std::int32_t>::max();
+  std::printf("%zu queries, times per query\n", queries_count);
+  std::printf("%10s %20s %10s %12s %10s\n", "size", "structure", "build, ms",
+              "memory, MiB", "query, ns");
+  for (const std::size_t size : {10'000ULL, 1'000'000ULL}) {
+    std::mt19937 gen(37);
+    std::vector<std::int32_t> vec(size);
+    for (std::int32_t& value : vec) {
+      value = static_cast<std::int32_t>(gen());
+    }
+    const auto print = [size](const char* structure_name,
+                              const ads::TreeMeasurement& measurement) {
+      std::printf("%10zu %20s %10.1f %12.1f %10.1f\n", size, structure_name,
+                  measurement.build_time_ms_, measurement.memory_mib_,
+                  measurement.query_time_ns_);
+    };
+    print("SegmentTree",
+          ads::measureTree<ads::SegmentTree<std::int32_t, Min, kMax>>(
+              vec, queries_count, 370));
+    print("SparseTable",
+          ads::measureTree<ads::SparseTable<std::int32_t, Min>>(
+              vec, queries_count, 370));
+    print("DisjointSparseTable",
+          ads::measureTree<ads::DisjointSparseTable<std::int32_t, Min>>(
+              vec, queries_count, 370));
+  }
+  return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+#include "data_structures/wide_segment_tree/wide_segment_tree.hpp"
+
+namespace {
+
+template <typename Functor, std::int32_t kNeutralElement>
+void compareTrees(const char* operation_name,
+                  const std::vector<std::int32_t>& vec,
+                  const std::size_t& operations_count) {
+  const auto print = [&](const char* tree_name,
+                         const ads::TreeMeasurement& measurement) {
+    std::printf("%10zu %4s %12s %10.1f %12.1f %10.0f %10.0f\n", vec.size(),
+                operation_name, tree_name, measurement.build_time_ms_,
+                measurement.memory_mib_, measurement.query_time_ns_,
+                measurement.update_time_ns_);
+  };
+  print("SegmentTree",
+        ads::measureTree<
+            ads::SegmentTree<std::int32_t, Functor, kNeutralElement>>(
+            vec, operations_count, 350));
+  print("Wide",
+        ads::measureTree<
+            ads::WideSegmentTree<std::int32_t, Functor, kNeutralElement>>(
+            vec, operations_count, 350));
+}
+
+}  // namespace
+
+// WideSegmentTree against SegmentTree, int32 sums and minimums. Usage:
+// bench_wide_segment_tree [max size, default: 10^7]
+int main(int argc, char* argv[]) {
+  constexpr std::size_t kOperationsCount = 1'000'000;
+  const std::size_t max_size =
+      (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+  std::printf("%zu queries and updates, times per operation\n",
+              kOperationsCount);
+  std::printf("%10s %4s %12s %10s %12s %10s %10s\n", "size", "op", "tree",
+              "build, ms", "memory, MiB", "query, ns", "update, ns");
+  for (std::size_t size = 1'000'000; size <= max_size; size *= 10) {
+    std::mt19937 gen(35);
+    std::vector<std::int32_t> vec(size);
+    for (std::int32_t& value : vec) {
+      value = static_cast<std::int32_t>(gen() % 1000);
+    }
+    compareTrees<ads::Sum<std::int32_t>, 0>("sum", vec, kOperationsCount);
+    compareTrees<ads::Min<std::int32_t>,
+                 std::numeric_limits<std::int32_t>::max()>("min", vec,
+                                                           kOperationsCount);
+  }
+  return 0;
+}
@@ -0,0 +1,254 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_ADDRESSABLE_HEAP_ADDRESSABLE_HEAP_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_ADDRESSABLE_HEAP_ADDRESSABLE_HEAP_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ads {
+
+// kArity-ary heap whose elements can be changed or erased through the handle
+// returned by push. The elements are stored together with their handles in
+// one array and positions_ maps a handle to the index of its element, so
+// every move of an element during sifting also updates its position.
+// A handle is valid until its element is popped or erased, after that push
+// may return the same handle for a new element. Compare(a, b) is true when
+// a must be closer to the top than b, like in Heap
+template <typename T, typename Compare, std::size_t kArity = 2>
+class AddressableHeap {
+  static_assert(kArity >= 2, "Heap arity must be at least 2");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+  using handle_type = std::size_t;
+  using const_reference = const T&;
+
+  AddressableHeap()
+      : heap_(),
+        positions_(),
+        free_handle_(kNoHandle),
+        comparator_() {}
+
+  // Element access
+  [[nodiscard]] const_reference top() const {
+    if (heap_.empty()) {
+      throw std::length_error("Heap is empty");
+    }
+    return heap_.front().value_;
+  }
+
+  [[nodiscard]] handle_type topHandle() const {
+    if (heap_.empty()) {
+      throw std::length_error("Heap is empty");
+    }
+    return heap_.front().handle_;
+  }
+
+  [[nodiscard]] const_reference value(const handle_type& handle) const {
+    return heap_[position(handle)].value_;
+  }
+
+  // Capacity
+  [[nodiscard]] bool empty() const noexcept {
+    return heap_.empty();
+  }
+
+  [[nodiscard]] size_type getSize() const noexcept {
+    return heap_.size();
+  }
+
+  // Whether handle refers to an element of the heap. The position of a free
+  // handle holds the next free handle, so it is checked against the handle
+  // stored with the element
+  [[nodiscard]] bool contains(const handle_type& handle) const noexcept {
+    return (handle < positions_.size()) &&
+           (positions_[handle] < heap_.size()) &&
+           (heap_[positions_[handle]].handle_ == handle);
+  }
+
+  // Modifiers
+  handle_type push(const value_type& value) {
+    return emplace(value);
+  }
+
+  handle_type push(value_type&& value) {
+    return emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  handle_type emplace(Args&&... args) {
+    // The element is created before the array grows, args may refer to an
+    // element of the heap
+    heap_.push_back(Entry{value_type(std::forward<Args>(args)...), kNoHandle});
+    handle_type handle = free_handle_;
+    if (handle == kNoHandle) {
+      try {
+        positions_.push_back(kNoHandle);
+      } catch (...) {
+        heap_.pop_back();
+        throw;
+      }
+      handle = positions_.size() - 1;
+    } else {
+      free_handle_ = positions_[handle];
+    }
+    heap_.back().handle_ = handle;
+    positions_[handle] = heap_.size() - 1;
+    siftingUp(heap_.size() - 1);
+    return handle;
+  }
+
+  void pop() {
+    if (heap_.empty()) {
+      throw std::length_error("Heap is empty");
+    }
+    erase(heap_.front().handle_);
+  }
+
+  void erase(const handle_type& handle) {
+    const size_type index = position(handle);
+    positions_[handle] = free_handle_;
+    free_handle_ = handle;
+    if (index + 1 == heap_.size()) {
+      heap_.pop_back();
+      return;
+    }
+    place(index, std::move(heap_.back()));
+    heap_.pop_back();
+    restore(index);
+  }
+
+  // Moves the element towards the top, new_value must not be farther from
+  // the top than the current value (not greater for a min-heap)
+  void decreaseKey(const handle_type& handle, value_type new_value) {
+    const size_type index = position(handle);
+    if (comparator_(heap_[index].value_, new_value)) {
+      throw std::invalid_argument(
+          "New value must not be farther from the top than the current one");
+    }
+    heap_[index].value_ = std::move(new_value);
+    siftingUp(index);
+  }
+
+  // Moves the element away from the top, new_value must not be closer to
+  // the top than the current value (not less for a min-heap)
+  void increaseKey(const handle_type& handle, value_type new_value) {
+    const size_type index = position(handle);
+    if (comparator_(new_value, heap_[index].value_)) {
+      throw std::invalid_argument(
+          "New value must not be closer to the top than the current one");
+    }
+    heap_[index].value_ = std::move(new_value);
+    siftingDown(index);
+  }
+
+  // Changes the value in any direction
+  void update(const handle_type& handle, value_type new_value) {
+    const size_type index = position(handle);
+    heap_[index].value_ = std::move(new_value);
+    restore(index);
+  }
+
+  void clear() noexcept {
+    heap_.clear();
+    positions_.clear();
+    free_handle_ = kNoHandle;
+  }
+
+private:
+  struct Entry {
+    value_type value_;
+    handle_type handle_;
+  };
+
+  static constexpr handle_type kNoHandle =
+      std::numeric_limits<handle_type>::max();
+
+  // Sifting moves a hole instead of swapping, an exception in the middle
+  // would leave a moved-from element in the heap
+  static constexpr bool kIsNothrowSifting =
+      std::is_nothrow_move_constructible_v<T> &&
+      std::is_nothrow_move_assignable_v<T> &&
+      std::is_nothrow_invocable_v<Compare&, const T&, const T&>;
+
+  [[nodiscard]] size_type position(const handle_type& handle) const {
+    if (!contains(handle)) {
+      throw std::range_error("Handle does not refer to an element of the heap");
+    }
+    return positions_[handle];
+  }
+
+  void place(const size_type& index, Entry&& entry) noexcept(
+      kIsNothrowSifting) {
+    positions_[entry.handle_] = index;
+    heap_[index] = std::move(entry);
+  }
+
+  // Returns the child which must be the parent of the others
+  [[nodiscard]] size_type selectChild(const size_type& first_child) {
+    const size_type last_child =
+        std::min(first_child + kArity, heap_.size());
+    size_type selected_child = first_child;
+    for (size_type child = first_child + 1; child < last_child; ++child) {
+      selected_child =
+          comparator_(heap_[child].value_, heap_[selected_child].value_)
+              ? child
+              : selected_child;
+    }
+    return selected_child;
+  }
+
+  void siftingDown(size_type index) noexcept(kIsNothrowSifting) {
+    Entry entry = std::move(heap_[index]);
+    size_type first_child = kArity * index + 1;
+    while (first_child < heap_.size()) {
+      const size_type selected_child = selectChild(first_child);
+      if (!comparator_(heap_[selected_child].value_, entry.value_)) {
+        break;
+      }
+      place(index, std::move(heap_[selected_child]));
+      index = selected_child;
+      first_child = kArity * index + 1;
+    }
+    place(index, std::move(entry));
+  }
+
+  void siftingUp(size_type index) noexcept(kIsNothrowSifting) {
+    Entry entry = std::move(heap_[index]);
+    while (index > 0) {
+      const size_type parent = (index - 1) / kArity;
+      if (!comparator_(entry.value_, heap_[parent].value_)) {
+        break;
+      }
+      place(index, std::move(heap_[parent]));
+      index = parent;
+    }
+    place(index, std::move(entry));
+  }
+
+  // Sifts the changed element at index in the direction it must go
+  void restore(const size_type& index) noexcept(kIsNothrowSifting) {
+    if ((index > 0) &&
+        comparator_(heap_[index].value_, heap_[(index - 1) / kArity].value_)) {
+      siftingUp(index);
+    } else {
+      siftingDown(index);
+    }
+  }
+
+  std::vector<Entry> heap_;
+  // Index in heap_ for a handle in use, the next free handle otherwise
+  std::vector<size_type> positions_;
+  handle_type free_handle_;
+  Compare comparator_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_ADDRESSABLE_HEAP_ADDRESSABLE_HEAP_HPP_
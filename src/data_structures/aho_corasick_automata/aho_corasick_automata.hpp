@@ -1,20 +1,63 @@
 #ifndef CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_AHO_CORASICK_AUTOMATA_HPP_
 #define CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_AHO_CORASICK_AUTOMATA_HPP_
 
+#include <array>
 #include <vector>
 #include <string>
 #include <queue>
 #include <cstdint>
 #include <limits>
 #include <algorithm>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <tmmintrin.h>
+#endif
 
 namespace ads {
 
-// TODO: add tests
+// Layout of a file written by AhoCorasickAutomata::saveToFile: the header,
+// one record of (2 + alphabet size) std::uint64_t per node: outputs_begin,
+// outputs_end, next[alphabet size], then outputs_count pairs of
+// std::uint64_t: str_num, str_size. Links are node and output indices, so
+// the file can be mapped at any address
+struct AhoCorasickFileHeader {
+  std::uint64_t magic;
+  std::uint64_t version;
+  std::int64_t alpha_left;
+  std::int64_t alpha_right;
+  std::uint64_t nodes_count;
+  std::uint64_t outputs_count;
+  std::uint64_t checksum;
+};
+
+inline constexpr std::uint64_t kAhoCorasickFileMagic = 0x434F48415344410AULL;
+inline constexpr std::uint64_t kAhoCorasickFileVersion = 2;
+
+// FNV-1a hash of the words [begin, end) continuing from hash
+[[nodiscard]] inline std::uint64_t ahoCorasickChecksum(
+    const std::uint64_t* begin, const std::uint64_t* end,
+    std::uint64_t hash = 0xCBF29CE484222325ULL) noexcept {
+  for (; begin != end; ++begin) {
+    hash ^= *begin;
+    hash *= 0x100000001B3ULL;
+  }
+  return hash;
+}
+
+// Every node stores the full transition table, which makes a transition a
+// single lookup. CompactAhoCorasickAutomata has the same addString and
+// findAllOccurrences(text), stores only trie edges and is meant to be built
+// once
 template <char kAlphaLeft, char kAlphaRight>
 requires(kAlphaRight >= kAlphaLeft)
 class AhoCorasickAutomata {
 private:
+  struct Node;
+  struct StringInfo;
+  struct OutputInfo;
   struct OccurrenceInfo;
 
 public:
@@ -23,66 +66,577 @@ public:
   AhoCorasickAutomata()
       : is_built_(false),
         next_str_num_(0),
-        nodes_(std::vector<Node>(1)) {}
+        max_str_size_(0),
+        nodes_(std::vector<Node>(1)),
+        is_delta_built_(false),
+        delta_nodes_(std::vector<Node>(1)),
+        delta_build_work_(0),
+        are_outputs_outdated_(false),
+        are_delta_outputs_outdated_(false),
+        can_skip_root_(false),
+        is_start_byte_{},
+        start_bytes_low_{},
+        start_bytes_high_{} {}
 
+  // Strings added after the automaton was built go to a small delta
+  // automaton scanned together with the main one, so the main automaton is
+  // not rebuilt. The delta is merged into the main automaton when it grows
+  // beyond 1/kDeltaMergeRatio of it, when rebuilding it for searches has
+  // cost about as much as a merge, or when mergeDelta() is called. The
+  // merge is synchronous: the addString or search call which triggers it
+  // rebuilds the whole dictionary, the cost is amortized over the added
+  // strings
   void addString(const std::string& s) {
-    std::size_t curr_node = 0;
-    for (const char& symbol : s) {
-      const std::size_t symbol_ind =
-          static_cast<std::size_t>(symbol - kAlphaLeft);
-      if (nodes_[curr_node].next_[symbol_ind] == kUndefinedFlag) {
-        is_built_ = false;
-        nodes_[curr_node].next_[symbol_ind] = nodes_.size();
-        nodes_.emplace_back();
+    const std::size_t str_num = next_str_num_++;
+    strings_.push_back(StringInfo{.str_size_ = s.size(),
+                                  .next_same_node_ = kUndefinedFlag,
+                                  .is_removed_ = false});
+    max_str_size_ = std::max(max_str_size_, s.size());
+    if (!is_built_) {
+      insertString(nodes_, s, str_num);
+      return;
+    }
+    if (is_delta_built_) {
+      resetAutomata(delta_nodes_);
+      is_delta_built_ = false;
+    }
+    insertString(delta_nodes_, s, str_num);
+    if (delta_nodes_.size() >
+        std::max(kMinDeltaMergeSize, nodes_.size() / kDeltaMergeRatio)) {
+      mergeDelta();
+    }
+  }
+
+  // Returns false if s is not in the dictionary. Transitions are kept, only
+  // the output lists are repacked before the next search
+  bool removeString(const std::string& s) {
+    const bool is_removed_from_main = markRemoved(nodes_, s);
+    const bool is_removed_from_delta = markRemoved(delta_nodes_, s);
+    are_outputs_outdated_ = are_outputs_outdated_ || is_removed_from_main;
+    are_delta_outputs_outdated_ =
+        are_delta_outputs_outdated_ || is_removed_from_delta;
+    return is_removed_from_main || is_removed_from_delta;
+  }
+
+  // Moves strings of the delta automaton to the main one and rebuilds it.
+  // Costs as much as building the whole dictionary from scratch
+  void mergeDelta() {
+    if (!hasDelta()) {
+      return;
+    }
+    resetAutomata(nodes_);
+    std::vector<std::pair<std::size_t, std::size_t>> nodes_stack{{0, 0}};
+    while (!nodes_stack.empty()) {
+      const auto [delta_node, node] = nodes_stack.back();
+      nodes_stack.pop_back();
+      std::size_t str_num = delta_nodes_[delta_node].strings_head_;
+      while (str_num != kUndefinedFlag) {
+        const std::size_t next_str_num = strings_[str_num].next_same_node_;
+        strings_[str_num].next_same_node_ = nodes_[node].strings_head_;
+        nodes_[node].strings_head_ = str_num;
+        str_num = next_str_num;
+      }
+      for (std::size_t symbol_ind = 0;
+           symbol_ind < static_cast<std::size_t>(kAlphaSize); ++symbol_ind) {
+        const std::size_t delta_child =
+            trieChild(delta_nodes_, delta_node, symbol_ind);
+        if (delta_child == kUndefinedFlag) {
+          continue;
+        }
+        if (nodes_[node].next_[symbol_ind] == kUndefinedFlag) {
+          nodes_[node].next_[symbol_ind] = nodes_.size();
+          nodes_.emplace_back();
+          nodes_.back().depth_ = nodes_[node].depth_ + 1;
+        }
+        nodes_stack.emplace_back(delta_child, nodes_[node].next_[symbol_ind]);
       }
-      curr_node = nodes_[curr_node].next_[symbol_ind];
     }
-    nodes_[curr_node].is_terminal_ = true;
-    nodes_[curr_node].str_num_ = next_str_num_++;
-    nodes_[curr_node].str_size_ = s.size();
+    buildAutomata(nodes_);
+    buildOutputs(nodes_, outputs_);
+    is_built_ = true;
+    are_outputs_outdated_ = false;
+    delta_nodes_ = std::vector<Node>(1);
+    delta_outputs_.clear();
+    is_delta_built_ = false;
+    delta_build_work_ = 0;
+    are_delta_outputs_outdated_ = false;
+    buildStartSymbols();
   }
 
   // Return pairs[index of end position of string in text, string index]
   [[nodiscard]] occurrences findAllOccurrences(const std::string& text) {
-    if (!is_built_) {
-      buildAutomata();
-      is_built_ = true;
-    }
-    std::size_t curr_node = 0;
+    buildIfNeeded();
     std::vector<OccurrenceInfo> occurences;
+    scanText(text, 0, text.size(), 0, occurences);
+    return occurences;
+  }
+
+  // Splits text into chunks that are scanned concurrently. Every worker
+  // starts (max added string size - 1) symbols before its chunk, so an
+  // occurrence crossing a chunk border is reported only by the chunk where it
+  // ends. The result is the same as the one of findAllOccurrences(text).
+  // Like SegmentTree, scans on one thread unless threads_count is given
+  [[nodiscard]] occurrences findAllOccurrencesParallel(
+      const std::string& text, std::size_t threads_count = 1) {
+    buildIfNeeded();
     const std::size_t text_size = text.size();
-    for (std::size_t i = 0; i < text_size; ++i) {
-      curr_node = nodes_[curr_node].next_[text[i] - kAlphaLeft];
-      std::size_t traverse_back_node = curr_node;
-      do {
-        if (nodes_[traverse_back_node].is_terminal_) {
-          occurences.push_back(OccurrenceInfo{
-              .str_start_pos_ =
-                  ((i + 1) - nodes_[traverse_back_node].str_size_),
-              .str_num_ = nodes_[traverse_back_node].str_num_});
-        }
-        traverse_back_node = nodes_[traverse_back_node].to_terminal_link_;
-      } while (traverse_back_node != kNoPathFlag);
+    const std::size_t chunks_count = std::max(
+        std::size_t{1},
+        std::min(threads_count, text_size / kMinParallelChunkSize));
+    const std::size_t chunk_size =
+        (text_size + chunks_count - 1) / chunks_count;
+    const std::size_t overlap = std::max(max_str_size_, std::size_t{1}) - 1;
+    std::vector<std::future<occurrences>> chunks_occurrences;
+    chunks_occurrences.reserve(chunks_count);
+    for (std::size_t chunk = 0; chunk < chunks_count; ++chunk) {
+      const std::size_t chunk_begin = std::min(chunk * chunk_size, text_size);
+      const std::size_t chunk_end =
+          std::min(chunk_begin + chunk_size, text_size);
+      const std::size_t scan_begin =
+          chunk_begin > overlap ? chunk_begin - overlap : 0;
+      chunks_occurrences.push_back(
+          std::async(std::launch::async,
+                     [this, &text, scan_begin, chunk_begin, chunk_end] {
+                       occurrences chunk_occurrences;
+                       scanText(text, scan_begin, chunk_end, chunk_begin,
+                                chunk_occurrences);
+                       return chunk_occurrences;
+                     }));
+    }
+    occurrences occurences;
+    for (std::future<occurrences>& chunk_occurrences : chunks_occurrences) {
+      const occurrences found = chunk_occurrences.get();
+      occurences.insert(occurences.end(), found.begin(), found.end());
     }
     return occurences;
   }
 
+  // Scans every text independently. Up to kInterleaveWidth texts are advanced
+  // in lockstep and the next transition of each of them is prefetched, so
+  // cache misses of different texts overlap instead of being serialized.
+  // Result[i] is the same as findAllOccurrences(texts[i])
+  [[nodiscard]] std::vector<occurrences> findAllOccurrences(
+      const std::vector<std::string>& texts) {
+    buildIfNeeded();
+    std::vector<occurrences> texts_occurrences(texts.size());
+    std::array<ScanLane, kInterleaveWidth> lanes{};
+    std::size_t lanes_count = 0;
+    std::size_t next_text = 0;
+    while ((lanes_count < kInterleaveWidth) && (next_text < texts.size())) {
+      lanes[lanes_count++] =
+          ScanLane{.text_ind_ = next_text++,
+                   .pos_ = 0,
+                   .node_ = 0,
+                   .delta_node_ = 0};
+    }
+    while (lanes_count > 0) {
+      for (std::size_t lane = 0; lane < lanes_count;) {
+        ScanLane& scan_lane = lanes[lane];
+        const std::string& text = texts[scan_lane.text_ind_];
+        if (scan_lane.pos_ == text.size()) {
+          if (next_text < texts.size()) {
+            scan_lane = ScanLane{.text_ind_ = next_text++,
+                                 .pos_ = 0,
+                                 .node_ = 0,
+                                 .delta_node_ = 0};
+          } else {
+            scan_lane = lanes[--lanes_count];
+          }
+          continue;
+        }
+        const std::size_t symbol_ind = symbolIndex(text[scan_lane.pos_]);
+        scan_lane.node_ = nodes_[scan_lane.node_].next_[symbol_ind];
+        reportOccurrences(outputs_, nodes_[scan_lane.node_], scan_lane.pos_,
+                          texts_occurrences[scan_lane.text_ind_]);
+        if (is_delta_built_) {
+          scan_lane.delta_node_ =
+              delta_nodes_[scan_lane.delta_node_].next_[symbol_ind];
+          reportOccurrences(delta_outputs_,
+                            delta_nodes_[scan_lane.delta_node_],
+                            scan_lane.pos_,
+                            texts_occurrences[scan_lane.text_ind_]);
+        }
+        ++scan_lane.pos_;
+        if (scan_lane.pos_ < text.size()) {
+          const std::size_t next_symbol_ind = symbolIndex(text[scan_lane.pos_]);
+          __builtin_prefetch(&nodes_[scan_lane.node_].next_[next_symbol_ind]);
+        }
+        ++lane;
+      }
+    }
+    return texts_occurrences;
+  }
+
+  // Writes the built automaton in the flat format described by
+  // AhoCorasickFileHeader, the delta automaton is merged first. The file can
+  // be scanned in place with MappedAhoCorasickAutomata
+  void saveToFile(const std::string& file_path) {
+    buildIfNeeded();
+    mergeDelta();
+    std::vector<std::uint64_t> record(kNodeRecordSize);
+    std::uint64_t checksum = ahoCorasickChecksum(nullptr, nullptr);
+    for (std::size_t node = 0; node < nodes_.size(); ++node) {
+      fillNodeRecord(node, record);
+      checksum = ahoCorasickChecksum(record.data(),
+                                     record.data() + kNodeRecordSize, checksum);
+    }
+    std::vector<std::uint64_t> packed_outputs;
+    packed_outputs.reserve(2 * outputs_.size());
+    for (const OutputInfo& output : outputs_) {
+      packed_outputs.push_back(output.str_num_);
+      packed_outputs.push_back(output.str_size_);
+    }
+    checksum = ahoCorasickChecksum(
+        packed_outputs.data(), packed_outputs.data() + packed_outputs.size(),
+        checksum);
+    const AhoCorasickFileHeader header{
+        .magic = kAhoCorasickFileMagic,
+        .version = kAhoCorasickFileVersion,
+        .alpha_left = kAlphaLeft,
+        .alpha_right = kAlphaRight,
+        .nodes_count = nodes_.size(),
+        .outputs_count = outputs_.size(),
+        .checksum = checksum};
+    std::ofstream file(file_path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      throw std::runtime_error("Failed to open file " + file_path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t node = 0; node < nodes_.size(); ++node) {
+      fillNodeRecord(node, record);
+      file.write(reinterpret_cast<const char*>(record.data()),
+                 static_cast<std::streamsize>(kNodeRecordSize *
+                                              sizeof(std::uint64_t)));
+    }
+    file.write(reinterpret_cast<const char*>(packed_outputs.data()),
+               static_cast<std::streamsize>(packed_outputs.size() *
+                                            sizeof(std::uint64_t)));
+    if (!file.flush()) {
+      throw std::runtime_error("Failed to write file " + file_path);
+    }
+  }
+
 private:
   static constexpr std::int64_t kAlphaSize =
       static_cast<std::int64_t>(kAlphaRight - kAlphaLeft) + 1;
   static constexpr std::size_t kUndefinedFlag =
       std::numeric_limits<std::size_t>::max();
   static constexpr std::size_t kNoPathFlag = kUndefinedFlag - 1;
+  static constexpr std::size_t kMinParallelChunkSize = 1ULL << 12;
+  static constexpr std::size_t kInterleaveWidth = 8;
+  static constexpr std::size_t kMinDeltaMergeSize = 1ULL << 10;
+  static constexpr std::size_t kDeltaMergeRatio = 16;
+  // A merge costs about kDeltaMergeCostRatio times more per node than a
+  // rebuild of the delta
+  static constexpr std::size_t kDeltaMergeCostRatio = 4;
+  static constexpr std::size_t kNodeRecordSize =
+      2 + static_cast<std::size_t>(kAlphaSize);
+
+  struct ScanLane {
+    std::size_t text_ind_;
+    std::size_t pos_;
+    std::size_t node_;
+    std::size_t delta_node_;
+  };
+
+  [[nodiscard]] static std::size_t symbolIndex(const char symbol) noexcept {
+    return static_cast<std::size_t>(symbol - kAlphaLeft);
+  }
+
+  // Scans text[scan_begin, scan_end) from the root and reports occurrences
+  // ending at report_begin or later. The delta automaton is advanced in
+  // lockstep with the main one
+  void scanText(const std::string& text, const std::size_t scan_begin,
+                const std::size_t scan_end, const std::size_t report_begin,
+                occurrences& occurences) const {
+    std::size_t curr_node = 0;
+    std::size_t curr_delta_node = 0;
+    for (std::size_t i = scan_begin; i < scan_end; ++i) {
+      if ((curr_node == 0) && (curr_delta_node == 0) && can_skip_root_) {
+        i = findStartSymbol(text, i, scan_end);
+        if (i == scan_end) {
+          break;
+        }
+      }
+      const std::size_t symbol_ind = symbolIndex(text[i]);
+      curr_node = nodes_[curr_node].next_[symbol_ind];
+      if (is_delta_built_) {
+        curr_delta_node = delta_nodes_[curr_delta_node].next_[symbol_ind];
+      }
+      if (i >= report_begin) {
+        reportOccurrences(outputs_, nodes_[curr_node], i, occurences);
+        if (is_delta_built_) {
+          reportOccurrences(delta_outputs_, delta_nodes_[curr_delta_node], i,
+                            occurences);
+        }
+      }
+    }
+  }
+
+  // Returns the first position in text[begin, end) holding a symbol that
+  // leaves the root, or end. Symbols that keep the automaton in the root
+  // report nothing, so the scan jumps over them
+  [[nodiscard]] std::size_t findStartSymbol(const std::string& text,
+                                            std::size_t begin,
+                                            const std::size_t end) const {
+#if defined(__x86_64__) || defined(__i386__)
+    if (cpuHasSsse3()) {
+      begin = findStartSymbolSsse3(text, begin, end);
+    }
+#endif
+    while ((begin < end) &&
+           !is_start_byte_[static_cast<unsigned char>(text[begin])]) {
+      ++begin;
+    }
+    return begin;
+  }
+
+#if defined(__x86_64__) || defined(__i386__)
+  // The SSSE3 path is compiled for every x86 build and picked at runtime, so
+  // a binary built without -mssse3 still uses it
+  [[nodiscard]] static bool cpuHasSsse3() noexcept {
+    static const bool has_ssse3 = [] {
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("ssse3") != 0;
+    }();
+    return has_ssse3;
+  }
+
+  // Byte set test over 16 bytes at a time: the low nibble of a byte selects
+  // a mask of its possible high nibbles in start_bytes_low_ (bytes < 0x80)
+  // or start_bytes_high_ (bytes >= 0x80), the high nibble selects a bit.
+  // Stops at the first block holding a start symbol, or at the last full
+  // block
+  __attribute__((target("ssse3"))) [[nodiscard]] std::size_t
+  findStartSymbolSsse3(const std::string& text, std::size_t begin,
+                       const std::size_t end) const {
+    const __m128i low_table = _mm_loadu_si128(
+        reinterpret_cast<const __m128i_u*>(start_bytes_low_.data()));
+    const __m128i high_table = _mm_loadu_si128(
+        reinterpret_cast<const __m128i_u*>(start_bytes_high_.data()));
+    const __m128i high_nibble_bit =
+        _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64,
+                      -128);
+    const __m128i low_nibble_mask = _mm_set1_epi8(0x0F);
+    const __m128i top_bit = _mm_set1_epi8(-128);
+    const __m128i zero = _mm_setzero_si128();
+    for (; begin + 16 <= end; begin += 16) {
+      const __m128i bytes = _mm_loadu_si128(
+          reinterpret_cast<const __m128i_u*>(text.data() + begin));
+      const __m128i masks = _mm_or_si128(
+          _mm_shuffle_epi8(low_table, bytes),
+          _mm_shuffle_epi8(high_table, _mm_xor_si128(bytes, top_bit)));
+      const __m128i bits = _mm_shuffle_epi8(
+          high_nibble_bit,
+          _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble_mask));
+      const unsigned int found =
+          static_cast<unsigned int>(_mm_movemask_epi8(
+              _mm_cmpeq_epi8(_mm_and_si128(masks, bits), zero))) ^
+          0xFFFFU;
+      if (found != 0) {
+        return begin + static_cast<std::size_t>(__builtin_ctz(found));
+      }
+    }
+    return begin;
+  }
+#endif
+
+  // Fills the byte set used by findStartSymbol
+  void buildStartSymbols() {
+    is_start_byte_.fill(false);
+    start_bytes_low_.fill(0);
+    start_bytes_high_.fill(0);
+    for (std::size_t symbol_ind = 0;
+         symbol_ind < static_cast<std::size_t>(kAlphaSize); ++symbol_ind) {
+      if ((nodes_[0].next_[symbol_ind] == 0) &&
+          (!is_delta_built_ || (delta_nodes_[0].next_[symbol_ind] == 0))) {
+        continue;
+      }
+      const auto byte = static_cast<unsigned char>(
+          static_cast<std::size_t>(static_cast<unsigned char>(kAlphaLeft)) +
+          symbol_ind);
+      is_start_byte_[byte] = true;
+      std::array<std::uint8_t, 16>& table =
+          (byte < 0x80) ? start_bytes_low_ : start_bytes_high_;
+      table[byte & 0x0FU] |=
+          static_cast<std::uint8_t>(1U << ((byte >> 4) & 7U));
+    }
+    can_skip_root_ =
+        (nodes_[0].outputs_begin_ == nodes_[0].outputs_end_) &&
+        (delta_nodes_[0].outputs_begin_ == delta_nodes_[0].outputs_end_);
+  }
+
+  // Reports all strings that end at text position end_pos while the
+  // automaton is in the node curr_node: a single read of its output list
+  static void reportOccurrences(const std::vector<OutputInfo>& outputs,
+                                const Node& curr_node,
+                                const std::size_t end_pos,
+                                occurrences& occurences) {
+    for (std::size_t output = curr_node.outputs_begin_;
+         output < curr_node.outputs_end_; ++output) {
+      occurences.push_back(OccurrenceInfo{
+          .str_start_pos_ = ((end_pos + 1) - outputs[output].str_size_),
+          .str_num_ = outputs[output].str_num_});
+    }
+  }
+
+  void insertString(std::vector<Node>& nodes, const std::string& s,
+                    const std::size_t str_num) {
+    std::size_t curr_node = 0;
+    for (const char& symbol : s) {
+      const std::size_t symbol_ind = symbolIndex(symbol);
+      if (nodes[curr_node].next_[symbol_ind] == kUndefinedFlag) {
+        nodes[curr_node].next_[symbol_ind] = nodes.size();
+        nodes.emplace_back();
+        nodes.back().depth_ = nodes[curr_node].depth_ + 1;
+      }
+      curr_node = nodes[curr_node].next_[symbol_ind];
+    }
+    strings_[str_num].next_same_node_ = nodes[curr_node].strings_head_;
+    nodes[curr_node].strings_head_ = str_num;
+  }
+
+  // Child of node in the trie or kUndefinedFlag. A transition added by
+  // buildAutomata never leads one level deeper, unlike a trie edge
+  [[nodiscard]] static std::size_t trieChild(const std::vector<Node>& nodes,
+                                             const std::size_t node,
+                                             const std::size_t symbol_ind) {
+    const std::size_t child = nodes[node].next_[symbol_ind];
+    if ((child == kUndefinedFlag) ||
+        (nodes[child].depth_ != nodes[node].depth_ + 1)) {
+      return kUndefinedFlag;
+    }
+    return child;
+  }
+
+  // Marks every copy of s in the trie as removed, output lists are not
+  // updated
+  bool markRemoved(const std::vector<Node>& nodes, const std::string& s) {
+    std::size_t curr_node = 0;
+    for (const char& symbol : s) {
+      curr_node = trieChild(nodes, curr_node, symbolIndex(symbol));
+      if (curr_node == kUndefinedFlag) {
+        return false;
+      }
+    }
+    bool is_removed = false;
+    for (std::size_t str_num = nodes[curr_node].strings_head_;
+         str_num != kUndefinedFlag;
+         str_num = strings_[str_num].next_same_node_) {
+      is_removed = is_removed || !strings_[str_num].is_removed_;
+      strings_[str_num].is_removed_ = true;
+    }
+    return is_removed;
+  }
+
+  // Drops transitions and links added by buildAutomata, so that strings can
+  // be inserted into the trie again
+  static void resetAutomata(std::vector<Node>& nodes) {
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+      for (std::size_t symbol_ind = 0;
+           symbol_ind < static_cast<std::size_t>(kAlphaSize); ++symbol_ind) {
+        nodes[node].next_[symbol_ind] = trieChild(nodes, node, symbol_ind);
+      }
+      nodes[node].suffix_link_ = kUndefinedFlag;
+    }
+  }
+
+  // Packs the output list of every node: strings ending in the node followed
+  // by the output list of its suffix link. Nodes are visited by depth, so
+  // the list of a suffix link is packed before it is copied
+  void buildOutputs(std::vector<Node>& nodes,
+                    std::vector<OutputInfo>& outputs) const {
+    std::vector<std::size_t> depth_begin(max_str_size_ + 2, 0);
+    for (const Node& node : nodes) {
+      ++depth_begin[node.depth_ + 1];
+    }
+    for (std::size_t depth = 1; depth < depth_begin.size(); ++depth) {
+      depth_begin[depth] += depth_begin[depth - 1];
+    }
+    std::vector<std::size_t> nodes_by_depth(nodes.size());
+    for (std::size_t node = 0; node < nodes.size(); ++node) {
+      nodes_by_depth[depth_begin[nodes[node].depth_]++] = node;
+    }
+    outputs.clear();
+    for (const std::size_t node : nodes_by_depth) {
+      nodes[node].outputs_begin_ = outputs.size();
+      for (std::size_t str_num = nodes[node].strings_head_;
+           str_num != kUndefinedFlag;
+           str_num = strings_[str_num].next_same_node_) {
+        if (!strings_[str_num].is_removed_) {
+          outputs.push_back(OutputInfo{
+              .str_num_ = str_num, .str_size_ = strings_[str_num].str_size_});
+        }
+      }
+      if (node != 0) {
+        const Node& suff_link_node = nodes[nodes[node].suffix_link_];
+        for (std::size_t output = suff_link_node.outputs_begin_;
+             output < suff_link_node.outputs_end_; ++output) {
+          const OutputInfo suff_link_output = outputs[output];
+          outputs.push_back(suff_link_output);
+        }
+      }
+      nodes[node].outputs_end_ = outputs.size();
+    }
+  }
+
+  [[nodiscard]] bool hasDelta() const noexcept {
+    return (delta_nodes_.size() > 1) ||
+           (delta_nodes_[0].strings_head_ != kUndefinedFlag);
+  }
+
+  void fillNodeRecord(const std::size_t node,
+                      std::vector<std::uint64_t>& record) const {
+    record[0] = nodes_[node].outputs_begin_;
+    record[1] = nodes_[node].outputs_end_;
+    std::copy(nodes_[node].next_, nodes_[node].next_ + kAlphaSize,
+              record.begin() + 2);
+  }
+
+  void buildIfNeeded() {
+    const bool has_delta = hasDelta();
+    if (is_built_ && (is_delta_built_ || !has_delta) &&
+        !are_outputs_outdated_ && !are_delta_outputs_outdated_) {
+      return;
+    }
+    // Strings added between searches make every search rebuild the delta,
+    // so its cost grows with the delta. Merging once the rebuilds cost about
+    // as much as a merge keeps alternating adds and searches at amortized
+    // O(sqrt(nodes)) rebuilt nodes per added string
+    if (has_delta && !is_delta_built_) {
+      delta_build_work_ += delta_nodes_.size();
+      if (delta_build_work_ > nodes_.size() * kDeltaMergeCostRatio) {
+        mergeDelta();
+        return;
+      }
+    }
+    if (!is_built_ || are_outputs_outdated_) {
+      if (!is_built_) {
+        buildAutomata(nodes_);
+        is_built_ = true;
+      }
+      buildOutputs(nodes_, outputs_);
+      are_outputs_outdated_ = false;
+    }
+    if (has_delta && (!is_delta_built_ || are_delta_outputs_outdated_)) {
+      if (!is_delta_built_) {
+        buildAutomata(delta_nodes_);
+        is_delta_built_ = true;
+      }
+      buildOutputs(delta_nodes_, delta_outputs_);
+      are_delta_outputs_outdated_ = false;
+    }
+    buildStartSymbols();
+  }
 
   // This function must be called after all strings was added
   // Aho-Corasick algorithm implementation
   // Lecture: https://www.youtube.com/watch?v=V7S80KpbQpk&list=LL&index=5&t=2s
-  void buildAutomata() {
-    nodes_[0].suffix_link_ = kNoPathFlag;
-    nodes_[0].to_terminal_link_ = kNoPathFlag;
+  static void buildAutomata(std::vector<Node>& nodes) {
+    nodes[0].suffix_link_ = kNoPathFlag;
     for (char c = kAlphaLeft; c <= kAlphaRight; ++c) {
-      if (nodes_[0].next_[c - kAlphaLeft] == kUndefinedFlag) {
-        nodes_[0].next_[c - kAlphaLeft] = 0;
+      if (nodes[0].next_[c - kAlphaLeft] == kUndefinedFlag) {
+        nodes[0].next_[c - kAlphaLeft] = 0;
       }
     }
     std::queue<std::size_t> nodes_queue;
@@ -91,25 +645,20 @@ private:
       std::size_t parent = nodes_queue.front();
       nodes_queue.pop();
       for (char c = kAlphaLeft; c <= kAlphaRight; ++c) {
-        std::size_t child = nodes_[parent].next_[c - kAlphaLeft];
-        if (nodes_[child].suffix_link_ != kUndefinedFlag) {
+        std::size_t child = nodes[parent].next_[c - kAlphaLeft];
+        if (nodes[child].suffix_link_ != kUndefinedFlag) {
           continue;
         }
-        nodes_[child].suffix_link_ =
+        nodes[child].suffix_link_ =
             (parent == 0
                  ? 0
-                 : nodes_[nodes_[parent].suffix_link_].next_[c - kAlphaLeft]);
-        const std::size_t& suff_link_node = nodes_[child].suffix_link_;
-        nodes_[child].to_terminal_link_ =
-            (nodes_[suff_link_node].is_terminal_
-                 ? suff_link_node
-                 : nodes_[suff_link_node].to_terminal_link_);
+                 : nodes[nodes[parent].suffix_link_].next_[c - kAlphaLeft]);
         for (char d = kAlphaLeft; d <= kAlphaRight; ++d) {
-          if (nodes_[child].next_[d - kAlphaLeft] != kUndefinedFlag) {
+          if (nodes[child].next_[d - kAlphaLeft] != kUndefinedFlag) {
             continue;
           }
-          nodes_[child].next_[d - kAlphaLeft] =
-              nodes_[nodes_[child].suffix_link_].next_[d - kAlphaLeft];
+          nodes[child].next_[d - kAlphaLeft] =
+              nodes[nodes[child].suffix_link_].next_[d - kAlphaLeft];
         }
         nodes_queue.push(child);
       }
@@ -117,22 +666,38 @@ private:
   }
 
   struct Node {
-    bool is_terminal_;
-    std::size_t str_num_;
-    std::size_t str_size_;
+    // Last added string ending in the node, see StringInfo
+    std::size_t strings_head_;
+    std::size_t depth_;
     std::size_t suffix_link_;
-    std::size_t to_terminal_link_;
-    std::size_t next_[kAlphaSize];
+    // Strings ending in the node or in its suffix links, a range of the
+    // output list of the automaton
+    std::size_t outputs_begin_;
+    std::size_t outputs_end_;
+    std::size_t next_[static_cast<std::size_t>(kAlphaSize)];
 
     Node()
-        : is_terminal_(false),
-          str_num_(kUndefinedFlag),
+        : strings_head_(kUndefinedFlag),
+          depth_(0),
           suffix_link_(kUndefinedFlag),
-          to_terminal_link_(kUndefinedFlag) {
+          outputs_begin_(0),
+          outputs_end_(0) {
       std::fill(next_, next_ + kAlphaSize, kUndefinedFlag);
     }
   };
 
+  // Strings ending in the same node form a list linked by next_same_node_
+  struct StringInfo {
+    std::size_t str_size_;
+    std::size_t next_same_node_;
+    bool is_removed_;
+  };
+
+  struct OutputInfo {
+    std::size_t str_num_;
+    std::size_t str_size_;
+  };
+
   struct OccurrenceInfo {
     std::size_t str_start_pos_;
     std::size_t str_num_;
@@ -140,7 +705,22 @@ private:
 
   bool is_built_;
   std::size_t next_str_num_;
+  std::size_t max_str_size_;
+  std::vector<StringInfo> strings_;
   std::vector<Node> nodes_;
+  std::vector<OutputInfo> outputs_;
+  bool is_delta_built_;
+  std::vector<Node> delta_nodes_;
+  std::vector<OutputInfo> delta_outputs_;
+  // Delta nodes built for searches since the last merge
+  std::size_t delta_build_work_;
+  bool are_outputs_outdated_;
+  bool are_delta_outputs_outdated_;
+  // Symbols leaving the root, see findStartSymbol
+  bool can_skip_root_;
+  std::array<bool, 256> is_start_byte_;
+  std::array<std::uint8_t, 16> start_bytes_low_;
+  std::array<std::uint8_t, 16> start_bytes_high_;
 };
 
 }  // namespace ads
@@ -0,0 +1,282 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_COMPACT_AHO_CORASICK_AUTOMATA_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_COMPACT_AHO_CORASICK_AUTOMATA_HPP_
+
+#include <vector>
+#include <string>
+#include <queue>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "aho_corasick_automata.hpp"
+
+namespace ads {
+
+// Aho-Corasick automaton that keeps only the trie edges instead of the full
+// transition table of AhoCorasickAutomata. Memory is O(nodes) instead of
+// O(nodes * alphabet size), a missing transition is resolved by following
+// suffix links. Children of every node are stored contiguously and sorted by
+// symbol, the root keeps a full transition table.
+// The compact mode is meant to be built once. It has no delta automaton and
+// no removeString: addString after a search unpacks the edges and the next
+// search rebuilds the whole automaton. Matches are reported by walking
+// terminal links instead of the flattened output lists of
+// AhoCorasickAutomata, which hold a copy of every output of a suffix link
+// and may outgrow the edges for dictionaries of nested strings
+template <char kAlphaLeft, char kAlphaRight>
+requires(kAlphaRight >= kAlphaLeft)
+class CompactAhoCorasickAutomata {
+public:
+  using occurrences =
+      typename AhoCorasickAutomata<kAlphaLeft, kAlphaRight>::occurrences;
+
+  CompactAhoCorasickAutomata()
+      : is_built_(false),
+        next_str_num_(0),
+        first_edge_(1, kNoNode),
+        strings_head_(1, kNoNode) {}
+
+  // O(nodes) after a search, since the automaton is rebuilt
+  void addString(const std::string& s) {
+    if (s.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("Too long automata string");
+    }
+    if (next_str_num_ >= kNoNode) {
+      throw std::length_error("Too many automata strings");
+    }
+    if (is_built_) {
+      restoreInsertEdges();
+    }
+    std::uint32_t curr_node = 0;
+    for (const char& symbol : s) {
+      std::uint32_t child = findInsertChild(curr_node, symbol);
+      if (child == kNoNode) {
+        if (strings_head_.size() >= kNoNode) {
+          throw std::length_error("Too many automata nodes");
+        }
+        child = static_cast<std::uint32_t>(strings_head_.size());
+        insert_edges_.push_back(InsertEdge{.symbol_ = symbol,
+                                           .target_ = child,
+                                           .next_ = first_edge_[curr_node]});
+        first_edge_[curr_node] =
+            static_cast<std::uint32_t>(insert_edges_.size() - 1);
+        first_edge_.push_back(kNoNode);
+        strings_head_.push_back(kNoNode);
+      }
+      curr_node = child;
+    }
+    strings_.push_back(
+        StringInfo{.str_size_ = static_cast<std::uint32_t>(s.size()),
+                   .next_same_node_ = strings_head_[curr_node]});
+    strings_head_[curr_node] = static_cast<std::uint32_t>(next_str_num_++);
+  }
+
+  // Return pairs[index of end position of string in text, string index]
+  [[nodiscard]] occurrences findAllOccurrences(const std::string& text) {
+    if (!is_built_) {
+      buildAutomata();
+      is_built_ = true;
+    }
+    std::uint32_t curr_node = 0;
+    occurrences occurences;
+    const std::size_t text_size = text.size();
+    for (std::size_t i = 0; i < text_size; ++i) {
+      curr_node = nextNode(curr_node, text[i]);
+      std::uint32_t traverse_back_node = curr_node;
+      do {
+        for (std::uint32_t str_num = strings_head_[traverse_back_node];
+             str_num != kNoNode; str_num = strings_[str_num].next_same_node_) {
+          occurences.push_back(
+              {.str_start_pos_ = (i + 1) - strings_[str_num].str_size_,
+               .str_num_ = str_num});
+        }
+        traverse_back_node = to_terminal_link_[traverse_back_node];
+      } while (traverse_back_node != kNoNode);
+    }
+    return occurences;
+  }
+
+private:
+  static constexpr std::size_t kAlphaSize =
+      static_cast<std::size_t>(kAlphaRight - kAlphaLeft) + 1;
+  static constexpr std::uint32_t kNoNode =
+      std::numeric_limits<std::uint32_t>::max();
+  static constexpr std::uint32_t kLinearSearchMaxEdges = 8;
+
+  [[nodiscard]] static std::size_t symbolIndex(const char symbol) noexcept {
+    return static_cast<std::size_t>(symbol - kAlphaLeft);
+  }
+
+  [[nodiscard]] std::uint32_t findInsertChild(
+      const std::uint32_t node, const char symbol) const noexcept {
+    for (std::uint32_t edge = first_edge_[node]; edge != kNoNode;
+         edge = insert_edges_[edge].next_) {
+      if (insert_edges_[edge].symbol_ == symbol) {
+        return insert_edges_[edge].target_;
+      }
+    }
+    return kNoNode;
+  }
+
+  // Trie child of node by symbol in the built automaton
+  [[nodiscard]] std::uint32_t findChild(const std::uint32_t node,
+                                        const char symbol) const noexcept {
+    if (node == 0) {
+      return root_next_[symbolIndex(symbol)];
+    }
+    const std::uint32_t edges_begin = edges_begin_[node];
+    const std::uint32_t edges_end = edges_begin_[node + 1];
+    if (edges_end - edges_begin <= kLinearSearchMaxEdges) {
+      for (std::uint32_t edge = edges_begin; edge < edges_end; ++edge) {
+        if (edge_symbols_[edge] == symbol) {
+          return edge_targets_[edge];
+        }
+      }
+      return kNoNode;
+    }
+    const auto symbols_end = edge_symbols_.begin() + edges_end;
+    const auto f_iter = std::lower_bound(edge_symbols_.begin() + edges_begin,
+                                         symbols_end, symbol);
+    if ((f_iter == symbols_end) || (*f_iter != symbol)) {
+      return kNoNode;
+    }
+    return edge_targets_[static_cast<std::size_t>(
+        f_iter - edge_symbols_.begin())];
+  }
+
+  // Transition of the automaton: follows suffix links until an edge by symbol
+  // is found. The root has all transitions, missing ones lead to the root
+  [[nodiscard]] std::uint32_t nextNode(std::uint32_t node,
+                                       const char symbol) const noexcept {
+    while (true) {
+      const std::uint32_t child = findChild(node, symbol);
+      if (child != kNoNode) {
+        return child;
+      }
+      if (node == 0) {
+        return 0;
+      }
+      node = suffix_link_[node];
+    }
+  }
+
+  // Packs the insertion edge lists into contiguous, sorted per node ranges
+  void packEdges() {
+    const std::size_t nodes_count = strings_head_.size();
+    edges_begin_.assign(nodes_count + 1, 0);
+    for (std::size_t node = 0; node < nodes_count; ++node) {
+      std::uint32_t children_count = 0;
+      for (std::uint32_t edge = first_edge_[node]; edge != kNoNode;
+           edge = insert_edges_[edge].next_) {
+        ++children_count;
+      }
+      edges_begin_[node + 1] = edges_begin_[node] + children_count;
+    }
+    edge_symbols_.resize(insert_edges_.size());
+    edge_targets_.resize(insert_edges_.size());
+    std::vector<std::pair<char, std::uint32_t>> children;
+    for (std::size_t node = 0; node < nodes_count; ++node) {
+      children.clear();
+      for (std::uint32_t edge = first_edge_[node]; edge != kNoNode;
+           edge = insert_edges_[edge].next_) {
+        children.emplace_back(insert_edges_[edge].symbol_,
+                              insert_edges_[edge].target_);
+      }
+      std::sort(children.begin(), children.end());
+      for (std::size_t i = 0; i < children.size(); ++i) {
+        edge_symbols_[edges_begin_[node] + i] = children[i].first;
+        edge_targets_[edges_begin_[node] + i] = children[i].second;
+      }
+    }
+    root_next_.assign(kAlphaSize, kNoNode);
+    for (std::uint32_t edge = edges_begin_[0]; edge < edges_begin_[1];
+         ++edge) {
+      root_next_[symbolIndex(edge_symbols_[edge])] = edge_targets_[edge];
+    }
+    std::vector<std::uint32_t>().swap(first_edge_);
+    std::vector<InsertEdge>().swap(insert_edges_);
+  }
+
+  // Inverse of packEdges, used when a string is added to a built automaton
+  void restoreInsertEdges() {
+    const std::size_t nodes_count = strings_head_.size();
+    first_edge_.assign(nodes_count, kNoNode);
+    insert_edges_.clear();
+    insert_edges_.reserve(edge_targets_.size());
+    for (std::size_t node = 0; node < nodes_count; ++node) {
+      for (std::uint32_t edge = edges_begin_[node];
+           edge < edges_begin_[node + 1]; ++edge) {
+        insert_edges_.push_back(InsertEdge{.symbol_ = edge_symbols_[edge],
+                                           .target_ = edge_targets_[edge],
+                                           .next_ = first_edge_[node]});
+        first_edge_[node] =
+            static_cast<std::uint32_t>(insert_edges_.size() - 1);
+      }
+    }
+    std::vector<std::uint32_t>().swap(edges_begin_);
+    std::vector<char>().swap(edge_symbols_);
+    std::vector<std::uint32_t>().swap(edge_targets_);
+    std::vector<std::uint32_t>().swap(root_next_);
+    is_built_ = false;
+  }
+
+  void buildAutomata() {
+    packEdges();
+    const std::size_t nodes_count = strings_head_.size();
+    suffix_link_.assign(nodes_count, 0);
+    to_terminal_link_.assign(nodes_count, kNoNode);
+    std::queue<std::uint32_t> nodes_queue;
+    nodes_queue.push(0);
+    while (!nodes_queue.empty()) {
+      const std::uint32_t parent = nodes_queue.front();
+      nodes_queue.pop();
+      for (std::uint32_t edge = edges_begin_[parent];
+           edge < edges_begin_[parent + 1]; ++edge) {
+        const std::uint32_t child = edge_targets_[edge];
+        if (parent != 0) {
+          suffix_link_[child] =
+              nextNode(suffix_link_[parent], edge_symbols_[edge]);
+        }
+        const std::uint32_t suff_link_node = suffix_link_[child];
+        to_terminal_link_[child] =
+            (strings_head_[suff_link_node] != kNoNode
+                 ? suff_link_node
+                 : to_terminal_link_[suff_link_node]);
+        nodes_queue.push(child);
+      }
+    }
+  }
+
+  struct InsertEdge {
+    char symbol_;
+    std::uint32_t target_;
+    std::uint32_t next_;
+  };
+
+  // Strings ending in the same node form a list linked by next_same_node_
+  struct StringInfo {
+    std::uint32_t str_size_;
+    std::uint32_t next_same_node_;
+  };
+
+  bool is_built_;
+  std::size_t next_str_num_;
+  // Trie edges as per node linked lists while strings are being added
+  std::vector<std::uint32_t> first_edge_;
+  std::vector<InsertEdge> insert_edges_;
+  // Trie edges of the built automaton: children of node are
+  // edge_symbols_/edge_targets_[edges_begin_[node], edges_begin_[node + 1])
+  std::vector<std::uint32_t> edges_begin_;
+  std::vector<char> edge_symbols_;
+  std::vector<std::uint32_t> edge_targets_;
+  std::vector<std::uint32_t> root_next_;
+  std::vector<std::uint32_t> suffix_link_;
+  std::vector<std::uint32_t> to_terminal_link_;
+  std::vector<std::uint32_t> strings_head_;
+  std::vector<StringInfo> strings_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_COMPACT_AHO_CORASICK_AUTOMATA_HPP_
@@ -0,0 +1,221 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_MAPPED_AHO_CORASICK_AUTOMATA_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_MAPPED_AHO_CORASICK_AUTOMATA_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include "aho_corasick_automata.hpp"
+
+namespace ads {
+
+// How much of a file MappedAhoCorasickAutomata checks when it is opened
+enum class AhoCorasickFileCheck {
+  // The header and the file size, O(1). The records are trusted: a damaged
+  // file may make a scan read outside the mapping
+  kTrusted,
+  // Also every node record, which reads the whole file
+  kStructure,
+  // Also the checksum of all records
+  kChecksum
+};
+
+// Read-only automaton scanned in place from a file written by
+// AhoCorasickAutomata::saveToFile. The file is mapped with MAP_SHARED, so
+// processes mapping the same file share its pages
+template <char kAlphaLeft, char kAlphaRight>
+requires(kAlphaRight >= kAlphaLeft)
+class MappedAhoCorasickAutomata {
+public:
+  using occurrences =
+      typename AhoCorasickAutomata<kAlphaLeft, kAlphaRight>::occurrences;
+
+  // With kStructure or kChecksum even a damaged file never makes a scan
+  // read outside the mapping, but opening reads every page of the file.
+  // kTrusted opens in O(1) and shares untouched pages with other processes,
+  // use it for files written by saveToFile which can not be changed by
+  // others
+  explicit MappedAhoCorasickAutomata(
+      const std::string& file_path,
+      const AhoCorasickFileCheck check = AhoCorasickFileCheck::kChecksum)
+      : mapped_data_(nullptr),
+        mapped_size_(0),
+        nodes_(nullptr),
+        outputs_(nullptr) {
+    const int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      throw std::runtime_error("Failed to open file " + file_path);
+    }
+    struct stat file_stat{};
+    if (::fstat(fd, &file_stat) == -1) {
+      ::close(fd);
+      throw std::runtime_error("Failed to stat file " + file_path);
+    }
+    mapped_size_ = static_cast<std::size_t>(file_stat.st_size);
+    if (mapped_size_ < sizeof(AhoCorasickFileHeader)) {
+      ::close(fd);
+      throw std::runtime_error("File is too small: " + file_path);
+    }
+    mapped_data_ =
+        ::mmap(nullptr, mapped_size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapped_data_ == MAP_FAILED) {
+      mapped_data_ = nullptr;
+      throw std::runtime_error("Failed to map file " + file_path);
+    }
+    try {
+      validate(check);
+    } catch (...) {
+      ::munmap(mapped_data_, mapped_size_);
+      throw;
+    }
+  }
+
+  MappedAhoCorasickAutomata(const MappedAhoCorasickAutomata& other) = delete;
+
+  MappedAhoCorasickAutomata& operator=(
+      const MappedAhoCorasickAutomata& other) = delete;
+
+  MappedAhoCorasickAutomata(MappedAhoCorasickAutomata&& other) noexcept
+      : mapped_data_(other.mapped_data_),
+        mapped_size_(other.mapped_size_),
+        nodes_(other.nodes_),
+        outputs_(other.outputs_) {
+    other.mapped_data_ = nullptr;
+    other.mapped_size_ = 0;
+    other.nodes_ = nullptr;
+    other.outputs_ = nullptr;
+  }
+
+  MappedAhoCorasickAutomata& operator=(
+      MappedAhoCorasickAutomata&& other) noexcept {
+    if (this != &other) {
+      unmap();
+      mapped_data_ = other.mapped_data_;
+      mapped_size_ = other.mapped_size_;
+      nodes_ = other.nodes_;
+      outputs_ = other.outputs_;
+      other.mapped_data_ = nullptr;
+      other.mapped_size_ = 0;
+      other.nodes_ = nullptr;
+      other.outputs_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~MappedAhoCorasickAutomata() {
+    unmap();
+  }
+
+  // Same result as AhoCorasickAutomata::findAllOccurrences(text)
+  [[nodiscard]] occurrences findAllOccurrences(const std::string& text) const {
+    std::size_t curr_node = 0;
+    occurrences occurences;
+    const std::size_t text_size = text.size();
+    for (std::size_t i = 0; i < text_size; ++i) {
+      curr_node = static_cast<std::size_t>(
+          record(curr_node)[2 + static_cast<std::size_t>(text[i] -
+                                                         kAlphaLeft)]);
+      const std::uint64_t* node_record = record(curr_node);
+      for (std::uint64_t output = node_record[0]; output < node_record[1];
+           ++output) {
+        const std::uint64_t* output_record = outputs_ + 2 * output;
+        occurences.push_back(
+            {.str_start_pos_ =
+                 (i + 1) - static_cast<std::size_t>(output_record[1]),
+             .str_num_ = static_cast<std::size_t>(output_record[0])});
+      }
+    }
+    return occurences;
+  }
+
+private:
+  static constexpr std::size_t kAlphaSize =
+      static_cast<std::size_t>(kAlphaRight - kAlphaLeft) + 1;
+  static constexpr std::size_t kNodeRecordSize = 2 + kAlphaSize;
+
+  [[nodiscard]] const std::uint64_t* record(
+      const std::size_t node) const noexcept {
+    return nodes_ + node * kNodeRecordSize;
+  }
+
+  void validate(const AhoCorasickFileCheck check) {
+    const auto* header =
+        static_cast<const AhoCorasickFileHeader*>(mapped_data_);
+    if (header->magic != kAhoCorasickFileMagic) {
+      throw std::runtime_error("Not an Aho-Corasick automata file");
+    }
+    if (header->version != kAhoCorasickFileVersion) {
+      throw std::runtime_error("Unsupported Aho-Corasick file version");
+    }
+    if ((header->alpha_left != kAlphaLeft) ||
+        (header->alpha_right != kAlphaRight)) {
+      throw std::runtime_error("Alphabet of the file does not match");
+    }
+    // The counts come from the file, so they are compared with the size by
+    // divisions which cannot overflow
+    const std::size_t body_size =
+        mapped_size_ - sizeof(AhoCorasickFileHeader);
+    const std::size_t words_count = body_size / sizeof(std::uint64_t);
+    const std::uint64_t nodes_count = header->nodes_count;
+    const std::uint64_t outputs_count = header->outputs_count;
+    if ((body_size % sizeof(std::uint64_t) != 0) || (nodes_count == 0) ||
+        (nodes_count > words_count / kNodeRecordSize) ||
+        (outputs_count >
+         (words_count - nodes_count * kNodeRecordSize) / 2) ||
+        (words_count !=
+         nodes_count * kNodeRecordSize + 2 * outputs_count)) {
+      throw std::runtime_error("Size of the file does not match its header");
+    }
+    nodes_ = reinterpret_cast<const std::uint64_t*>(header + 1);
+    outputs_ = nodes_ + nodes_count * kNodeRecordSize;
+    if (check == AhoCorasickFileCheck::kTrusted) {
+      return;
+    }
+    validateNodes(nodes_count, outputs_count);
+    if ((check == AhoCorasickFileCheck::kChecksum) &&
+        (ahoCorasickChecksum(nodes_, outputs_ + 2 * outputs_count) !=
+         header->checksum)) {
+      throw std::runtime_error("Checksum of the file does not match");
+    }
+  }
+
+  // Every transition must lead to a node of the file and every output range
+  // must lie inside the output records
+  void validateNodes(const std::uint64_t nodes_count,
+                     const std::uint64_t outputs_count) const {
+    for (std::size_t node = 0; node < nodes_count; ++node) {
+      const std::uint64_t* node_record = record(node);
+      if ((node_record[0] > node_record[1]) ||
+          (node_record[1] > outputs_count)) {
+        throw std::runtime_error("Output range of a node is out of the file");
+      }
+      for (std::size_t symbol_ind = 0; symbol_ind < kAlphaSize;
+           ++symbol_ind) {
+        if (node_record[2 + symbol_ind] >= nodes_count) {
+          throw std::runtime_error("Transition leads out of the file");
+        }
+      }
+    }
+  }
+
+  void unmap() noexcept {
+    if (mapped_data_ != nullptr) {
+      ::munmap(mapped_data_, mapped_size_);
+    }
+  }
+
+  void* mapped_data_;
+  std::size_t mapped_size_;
+  const std::uint64_t* nodes_;
+  const std::uint64_t* outputs_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_AHO_CORASICK_AUTOMATA_MAPPED_AHO_CORASICK_AUTOMATA_HPP_
@@ -0,0 +1,183 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_CONCURRENT_SEGMENT_TREE_CONCURRENT_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_CONCURRENT_SEGMENT_TREE_CONCURRENT_SEGMENT_TREE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Bottom-up segment tree, laid out like IterativeSegmentTree, that can be
+// queried from many threads while other threads update it. It keeps two
+// copies of the tree (the left-right technique): readers query the copy
+// read_tree_ind_ points to, a writer updates the other copy, switches the
+// readers to it, waits until no reader is left in the old copy and repeats
+// the update there. So readers never wait or retry, however often the tree
+// is written, and every query returns the state between two writes.
+// Writers are serialized by a mutex. Readers register in the counters of
+// the current version, and the version changes during a write, so the
+// writer waits only for the readers that came before the switch. All
+// atomics use sequentially consistent ordering, which the technique needs
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class ConcurrentSegmentTree {
+public:
+  explicit ConcurrentSegmentTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    std::vector<T>& segment_tree = segment_trees_[0];
+    segment_tree.resize(2 * vec_size_, kNeutralElement);
+    for (std::size_t vec_ind = 0; vec_ind < vec_size_; ++vec_ind) {
+      segment_tree[vec_ind + vec_size_] = vec[vec_ind];
+    }
+    for (std::size_t tree_ind = vec_size_ - 1; tree_ind > 0; --tree_ind) {
+      recompute(segment_tree, tree_ind);
+    }
+    segment_trees_[1] = segment_tree;
+  }
+
+  // Never blocks and never retries
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    std::atomic<std::size_t>& readers_count =
+        readers_counts_[version_ind_.load()][readerSlot()].count_;
+    readers_count.fetch_add(1);
+    const T result =
+        treeSegmentQuery(segment_trees_[read_tree_ind_.load()], left, right);
+    readers_count.fetch_sub(1);
+    return result;
+  }
+
+  void indexUpdate(const std::size_t& vec_ind, const T& new_vec_value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    write([&](std::vector<T>& segment_tree) {
+      treeIndexUpdate(segment_tree, vec_ind, new_vec_value);
+    });
+  }
+
+  // Sets the values of all updates in order, readers observe either none or
+  // all of them
+  void applyUpdates(std::span<const std::pair<std::size_t, T>> updates) {
+    for (const auto& update : updates) {
+      if (update.first >= vec_size_) {
+        throw std::range_error("Index exceeds the size of the vector");
+      }
+    }
+    write([&](std::vector<T>& segment_tree) {
+      for (const auto& [vec_ind, new_vec_value] : updates) {
+        treeIndexUpdate(segment_tree, vec_ind, new_vec_value);
+      }
+    });
+  }
+
+private:
+  static constexpr std::size_t kReaderSlotsCount = 16;
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  // Each counter has its own cache line, so readers in different slots do
+  // not contend
+  struct alignas(kCacheLineSize) ReadersCount {
+    std::atomic<std::size_t> count_ = 0;
+  };
+
+  [[nodiscard]] static std::size_t readerSlot() {
+    static thread_local const std::size_t slot =
+        std::hash<std::thread::id>()(std::this_thread::get_id()) %
+        kReaderSlotsCount;
+    return slot;
+  }
+
+  // Applies update_tree to the copy nobody reads, moves the readers to it
+  // and applies update_tree to the other copy once its readers are gone
+  template <typename UpdateTree>
+  void write(const UpdateTree& update_tree) {
+    const std::lock_guard<std::mutex> lock(writer_mutex_);
+    const std::size_t read_tree_ind = read_tree_ind_.load();
+    update_tree(segment_trees_[1 - read_tree_ind]);
+    read_tree_ind_.store(1 - read_tree_ind);
+    const std::size_t version_ind = version_ind_.load();
+    waitForReaders(1 - version_ind);
+    version_ind_.store(1 - version_ind);
+    waitForReaders(version_ind);
+    update_tree(segment_trees_[read_tree_ind]);
+  }
+
+  void waitForReaders(const std::size_t& version_ind) const {
+    for (const ReadersCount& readers_count : readers_counts_[version_ind]) {
+      while (readers_count.count_.load() != 0) {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void recompute(std::vector<T>& segment_tree, const std::size_t& tree_ind) {
+    segment_tree[tree_ind] = bin_operation_(segment_tree[2 * tree_ind],
+                                            segment_tree[2 * tree_ind + 1]);
+  }
+
+  [[nodiscard]] T treeSegmentQuery(const std::vector<T>& segment_tree,
+                                   const std::size_t& left,
+                                   const std::size_t& right) const {
+    T left_result = kNeutralElement;
+    T right_result = kNeutralElement;
+    std::size_t tree_left = left + vec_size_;
+    std::size_t tree_right = right + vec_size_ + 1;
+    while (tree_left < tree_right) {
+      if ((tree_left & 1) != 0) {
+        left_result = bin_operation_(left_result, segment_tree[tree_left++]);
+      }
+      if ((tree_right & 1) != 0) {
+        right_result = bin_operation_(segment_tree[--tree_right], right_result);
+      }
+      tree_left /= 2;
+      tree_right /= 2;
+    }
+    return bin_operation_(left_result, right_result);
+  }
+
+  void treeIndexUpdate(std::vector<T>& segment_tree,
+                       const std::size_t& vec_ind, const T& new_vec_value) {
+    std::size_t tree_ind = vec_ind + vec_size_;
+    segment_tree[tree_ind] = new_vec_value;
+    for (tree_ind /= 2; tree_ind > 0; tree_ind /= 2) {
+      recompute(segment_tree, tree_ind);
+    }
+  }
+
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  std::array<std::vector<T>, 2> segment_trees_;
+  // The copy new readers query
+  std::atomic<std::size_t> read_tree_ind_ = 0;
+  // The counters new readers register in
+  std::atomic<std::size_t> version_ind_ = 0;
+  mutable std::array<std::array<ReadersCount, kReaderSlotsCount>, 2>
+      readers_counts_;
+  std::mutex writer_mutex_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_CONCURRENT_SEGMENT_TREE_CONCURRENT_SEGMENT_TREE_HPP_
@@ -0,0 +1,149 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_DYNAMIC_SEGMENT_TREE_DYNAMIC_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_DYNAMIC_SEGMENT_TREE_DYNAMIC_SEGMENT_TREE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Segment tree over the indices [0, max_index], all values are initially
+// kNeutralElement. Nodes are created only on the paths of updated indices,
+// so memory is O(updates * log(max_index)) and max_index may be as large as
+// the maximum of std::uint64_t. Nodes are stored in a single vector and
+// refer to children by 32-bit indices, index 0 is a shared empty node
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class DynamicSegmentTree {
+public:
+  using index_type = std::uint64_t;
+
+  explicit DynamicSegmentTree(
+      const index_type& max_index = std::numeric_limits<index_type>::max())
+      : bin_operation_(),
+        max_index_(max_index) {
+    clear();
+  }
+
+  [[nodiscard]] T segmentQuery(const index_type& left,
+                               const index_type& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right > max_index_) {
+      throw std::range_error("The segment exceeds the index range");
+    }
+    return subtreeSegmentQuery(kRoot, 0, max_index_, left, right);
+  }
+
+  void indexUpdate(const index_type& ind, const T& new_value) {
+    if (ind > max_index_) {
+      throw std::range_error("Index exceeds the index range");
+    }
+    subtreeIndexUpdate(kRoot, 0, max_index_, ind, new_value);
+  }
+
+  [[nodiscard]] index_type maxIndex() const noexcept {
+    return max_index_;
+  }
+
+  // Number of created nodes, the empty node included
+  [[nodiscard]] std::size_t nodesCount() const noexcept {
+    return nodes_.size();
+  }
+
+  // Resets all values to kNeutralElement and frees the nodes
+  void clear() {
+    nodes_.assign(2, Node{.value_ = kNeutralElement,
+                          .left_child_ = kEmpty,
+                          .right_child_ = kEmpty});
+  }
+
+private:
+  static constexpr std::uint32_t kEmpty = 0;
+  static constexpr std::uint32_t kRoot = 1;
+
+  struct Node {
+    T value_;
+    std::uint32_t left_child_;
+    std::uint32_t right_child_;
+  };
+
+  std::uint32_t allocate() {
+    if (nodes_.size() > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::length_error("Too many segment tree nodes");
+    }
+    nodes_.push_back(Node{.value_ = kNeutralElement,
+                          .left_child_ = kEmpty,
+                          .right_child_ = kEmpty});
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+  }
+
+  [[nodiscard]] T subtreeSegmentQuery(const std::uint32_t& node,
+                                      const index_type& segment_left,
+                                      const index_type& segment_right,
+                                      const index_type& query_left,
+                                      const index_type& query_right) const {
+    if ((node == kEmpty) || (query_left > query_right)) {
+      return kNeutralElement;
+    }
+    if ((segment_left == query_left) && (segment_right == query_right)) {
+      return nodes_[node].value_;
+    }
+    const index_type segment_middle =
+        segment_left + (segment_right - segment_left) / 2;
+    return bin_operation_(
+        subtreeSegmentQuery(nodes_[node].left_child_, segment_left,
+                            segment_middle, query_left,
+                            std::min(query_right, segment_middle)),
+        subtreeSegmentQuery(nodes_[node].right_child_, segment_middle + 1,
+                            segment_right,
+                            std::max(query_left, segment_middle + 1),
+                            query_right));
+  }
+
+  // node is passed by value since allocate may reallocate nodes_
+  void subtreeIndexUpdate(const std::uint32_t node,
+                          const index_type& segment_left,
+                          const index_type& segment_right,
+                          const index_type& ind, const T& new_value) {
+    if (segment_left == segment_right) {
+      nodes_[node].value_ = new_value;
+      return;
+    }
+    const index_type segment_middle =
+        segment_left + (segment_right - segment_left) / 2;
+    if (ind <= segment_middle) {
+      if (nodes_[node].left_child_ == kEmpty) {
+        const std::uint32_t child = allocate();
+        nodes_[node].left_child_ = child;
+      }
+      subtreeIndexUpdate(nodes_[node].left_child_, segment_left,
+                         segment_middle, ind, new_value);
+    } else {
+      if (nodes_[node].right_child_ == kEmpty) {
+        const std::uint32_t child = allocate();
+        nodes_[node].right_child_ = child;
+      }
+      subtreeIndexUpdate(nodes_[node].right_child_, segment_middle + 1,
+                         segment_right, ind, new_value);
+    }
+    nodes_[node].value_ =
+        bin_operation_(nodes_[nodes_[node].left_child_].value_,
+                       nodes_[nodes_[node].right_child_].value_);
+  }
+
+  Functor bin_operation_;
+  index_type max_index_;
+  std::vector<Node> nodes_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_DYNAMIC_SEGMENT_TREE_DYNAMIC_SEGMENT_TREE_HPP_
@@ -0,0 +1,133 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_FENWICK_TREE_FENWICK_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_FENWICK_TREE_FENWICK_TREE_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Binary indexed tree of n elements with the interface of SegmentTree.
+// Functor must be commutative and have an inverse: InverseFunctor(a, b)
+// returns x such that Functor(b, x) == a, e.g. subtraction for sum and xor
+// for xor. segment_tree_[i - 1] holds the aggregate of the elements
+// (i - lowbit(i), i] in 1-based numbering
+template <typename T, typename Functor, T kNeutralElement,
+          typename InverseFunctor>
+requires BinaryOperator<Functor, T> && BinaryOperator<InverseFunctor, T> &&
+         std::is_copy_assignable_v<T>
+class FenwickTree {
+public:
+  explicit FenwickTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        inverse_operation_(),
+        vec_size_(vec.size()),
+        segment_tree_(vec) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    for (std::size_t tree_ind = 1; tree_ind <= vec_size_; ++tree_ind) {
+      const std::size_t parent_ind = tree_ind + lowBit(tree_ind);
+      if (parent_ind <= vec_size_) {
+        segment_tree_[parent_ind - 1] = bin_operation_(
+            segment_tree_[parent_ind - 1], segment_tree_[tree_ind - 1]);
+      }
+    }
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    if (left == 0) {
+      return prefix(right + 1);
+    }
+    return inverse_operation_(prefix(right + 1), prefix(left));
+  }
+
+  // Aggregate of the elements [0, right]
+  [[nodiscard]] T prefixQuery(const std::size_t& right) const {
+    if (right >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    return prefix(right + 1);
+  }
+
+  void indexUpdate(const std::size_t& vec_ind, const T& new_vec_value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    apply(vec_ind + 1, inverse_operation_(new_vec_value,
+                                          segmentQuery(vec_ind, vec_ind)));
+  }
+
+  // Replaces the element with Functor(element, value)
+  void indexApply(const std::size_t& vec_ind, const T& value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    apply(vec_ind + 1, value);
+  }
+
+  // The first index whose prefix aggregate is not less than prefix_value or
+  // the size of the vector if there is none. Prefix aggregates must be
+  // nondecreasing, e.g. sums of nonnegative elements
+  [[nodiscard]] std::size_t lowerBound(const T& prefix_value) const
+  requires std::totally_ordered<T>
+  {
+    std::size_t tree_ind = 0;
+    T tree_prefix = kNeutralElement;
+    for (std::size_t step = std::bit_floor(vec_size_); step > 0; step /= 2) {
+      if (tree_ind + step > vec_size_) {
+        continue;
+      }
+      const T next_prefix =
+          bin_operation_(tree_prefix, segment_tree_[tree_ind + step - 1]);
+      if (next_prefix < prefix_value) {
+        tree_ind += step;
+        tree_prefix = next_prefix;
+      }
+    }
+    return tree_ind;
+  }
+
+private:
+  [[nodiscard]] static std::size_t lowBit(const std::size_t tree_ind) {
+    return tree_ind & (~tree_ind + 1);
+  }
+
+  // Aggregate of the first count elements
+  [[nodiscard]] T prefix(std::size_t count) const {
+    T result = kNeutralElement;
+    for (; count > 0; count -= lowBit(count)) {
+      result = bin_operation_(result, segment_tree_[count - 1]);
+    }
+    return result;
+  }
+
+  void apply(std::size_t tree_ind, const T& value) {
+    for (; tree_ind <= vec_size_; tree_ind += lowBit(tree_ind)) {
+      segment_tree_[tree_ind - 1] =
+          bin_operation_(segment_tree_[tree_ind - 1], value);
+    }
+  }
+
+  Functor bin_operation_;
+  InverseFunctor inverse_operation_;
+  std::size_t vec_size_;
+  std::vector<T> segment_tree_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_FENWICK_TREE_FENWICK_TREE_HPP_
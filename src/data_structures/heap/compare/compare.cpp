@@ -1,12 +0,0 @@
-#include "compare.hpp"
-
-namespace ads {
-
-template <typename T>
-bool MoreCompare<T>::operator()(const T& left, const T& right) {
-  return left > right;
-}
-
-template class MoreCompare<int>;
-
-}  // namespace ads
@@ -6,7 +6,9 @@ namespace ads {
 template <typename T>
 class MoreCompare {
 public:
-  bool operator()(const T& left, const T& right);
+  bool operator()(const T& left, const T& right) const {
+    return left > right;
+  }
 };
 
 }  // namespace ads
@@ -1,12 +1,40 @@
 #ifndef CUSTOMADS_SRC_DATA_STRUCTURES_HEAP_HEAP_HEAP_HPP_
 #define CUSTOMADS_SRC_DATA_STRUCTURES_HEAP_HEAP_HEAP_HPP_
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <new>
+#include <ranges>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
 
 namespace ads {
 
-template <typename T, typename Compare>
+// Elements of a container passed as an rvalue are moved into the heap.
+// Elements of lvalue ranges and of views are copied, a temporary view still
+// refers to elements owned by someone else
+template <typename Range>
+constexpr bool kIsRangeMovable =
+    !std::is_lvalue_reference_v<Range> &&
+    !std::ranges::view<std::remove_cvref_t<Range>>;
+
+template <typename Range, typename T>
+concept HeapSourceRange =
+    std::ranges::input_range<Range> &&
+    std::constructible_from<
+        T, std::conditional_t<kIsRangeMovable<Range>,
+                              std::ranges::range_rvalue_reference_t<Range>,
+                              std::ranges::range_reference_t<Range>>>;
+
+// kArity is the number of children of a node, larger arity makes the heap
+// lower at the cost of more comparisons per level in siftingDown
+template <typename T, typename Compare, std::size_t kArity = 2>
 class Heap {
+  static_assert(kArity >= 2, "Heap arity must be at least 2");
+
 public:
   using value_type = T;
   using size_type = std::size_t;
@@ -20,13 +48,18 @@ public:
 
   Heap(value_type* construct_from_data, size_type size);
 
-  Heap(const Heap<T, Compare>& other);
+  // Builds the heap in O(n), the elements of an rvalue container are moved
+  template <HeapSourceRange<T> Range>
+  explicit Heap(Range&& range);
+
+  Heap(const Heap<T, Compare, kArity>& other);
 
-  Heap<T, Compare>& operator=(const Heap<T, Compare>& other);
+  Heap<T, Compare, kArity>& operator=(const Heap<T, Compare, kArity>& other);
 
   Heap(Heap&& other) noexcept;
 
-  Heap<T, Compare>& operator=(Heap<T, Compare>&& other) noexcept;
+  Heap<T, Compare, kArity>& operator=(
+      Heap<T, Compare, kArity>&& other) noexcept;
 
   ~Heap();
 
@@ -41,35 +74,65 @@ public:
   // Modifiers
   void push(const value_type& value);
 
-  void push(const value_type&& value);
+  void push(value_type&& value);
+
+  template <typename... Args>
+  void emplace(Args&&... args);
 
   void pop();
 
+  // Adds all elements of range, the elements of an rvalue container are
+  // moved. A large batch is added by rebuilding the whole heap in O(n)
+  template <HeapSourceRange<T> Range>
+  void pushRange(Range&& range);
+
+  // Moves count top elements to out in the heap order and removes them,
+  // returns the iterator past the last written element
+  template <typename OutputIterator>
+  OutputIterator popN(size_type count, OutputIterator out);
+
+  // Moves all elements of other to the heap, other becomes empty
+  void merge(Heap<T, Compare, kArity>&& other);
+
 private:
-  void swap(Heap<T, Compare>& other) noexcept;
+  // Sifting moves a hole instead of swapping, an exception in the middle
+  // would leave a moved-from element in the heap
+  static constexpr bool kIsNothrowSifting =
+      std::is_nothrow_move_constructible_v<T> &&
+      std::is_nothrow_move_assignable_v<T> &&
+      std::is_nothrow_invocable_v<Compare&, const T&, const T&>;
+
+  void swap(Heap<T, Compare, kArity>& other) noexcept;
 
   static void free(value_type* data_to_free,
                    size_type destructor_calls) noexcept;
 
   static void uninitializedCopy(value_type* copy_to,
-                                const Heap<T, Compare>& copy_from);
+                                const Heap<T, Compare, kArity>& copy_from);
 
   static void uninitializedCopy(value_type* copy_to,
                                 const value_type* copy_from, size_type size);
 
-  [[nodiscard]] size_type getLeft(size_type index) const noexcept;
-
-  [[nodiscard]] size_type getRight(size_type index) const noexcept;
+  [[nodiscard]] size_type getFirstChild(size_type index) const noexcept;
 
   [[nodiscard]] size_type getParent(size_type index) const noexcept;
 
+  [[nodiscard]] size_type selectChild(size_type first_child);
+
+  template <typename... Args>
+  void emplaceBack(Args&&... args);
+
   void resize();
 
-  void siftingDown(size_type index) noexcept(std::is_nothrow_swappable_v<T>);
+  void reallocate(size_type new_capacity);
+
+  void restoreHeap(size_type old_size) noexcept(kIsNothrowSifting);
 
-  void siftingUp(size_type index) noexcept(std::is_nothrow_swappable_v<T>);
+  void siftingDown(size_type index) noexcept(kIsNothrowSifting);
 
-  void makeHeap() noexcept(std::is_nothrow_swappable_v<T>);
+  void siftingUp(size_type index) noexcept(kIsNothrowSifting);
+
+  void makeHeap() noexcept(kIsNothrowSifting);
 
   value_type* data_;
   size_type size_;
@@ -77,6 +140,410 @@ private:
   value_compare comparator_;
 };
 
+// public
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::Heap()
+    : data_(nullptr),
+      size_(0),
+      capacity_(0),
+      comparator_(Compare()) {}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::Heap(const size_type capacity)
+    : data_(reinterpret_cast<value_type*>(
+          ::operator new(sizeof(value_type) * capacity))),
+      size_(0),
+      capacity_(capacity),
+      comparator_(Compare()) {}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::Heap(value_type* construct_from_data,
+                               size_type size)
+    : data_(reinterpret_cast<value_type*>(
+          ::operator new(sizeof(value_type) * size))),
+      size_(size),
+      capacity_(size),
+      comparator_(Compare()) {
+  uninitializedCopy(data_, construct_from_data, size);
+  makeHeap();
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+template <HeapSourceRange<T> Range>
+Heap<T, Compare, kArity>::Heap(Range&& range)
+    : Heap() {
+  pushRange(std::forward<Range>(range));
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::Heap(const Heap<T, Compare, kArity>& other)
+    : data_(reinterpret_cast<value_type*>(
+          ::operator new(sizeof(value_type) * other.capacity_))),
+      size_(other.size_),
+      capacity_(other.capacity_),
+      comparator_(Compare()) {
+  uninitializedCopy(data_, other);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>& Heap<T, Compare, kArity>::operator=(
+    const Heap<T, Compare, kArity>& other) {
+  if (this != &other) {
+    value_type* new_data = reinterpret_cast<value_type*>(
+        ::operator new(sizeof(value_type) * other.capacity_));
+    uninitializedCopy(new_data, other);
+    free(data_, size_);
+    data_ = new_data;
+    size_ = other.size_;
+    capacity_ = other.capacity_;
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::Heap(Heap&& other) noexcept
+    : data_(nullptr),
+      size_(0),
+      capacity_(0),
+      comparator_(Compare()) {
+  swap(other);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>& Heap<T, Compare, kArity>::operator=(
+    Heap<T, Compare, kArity>&& other) noexcept {
+  if (this != &other) {
+    free(data_, size_);
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+Heap<T, Compare, kArity>::~Heap() {
+  free(data_, size_);
+}
+
+// Element access
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] typename Heap<T, Compare, kArity>::const_reference
+Heap<T, Compare, kArity>::top() const {
+  if (size_ == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  return data_[0];
+}
+
+// Capacity
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] bool Heap<T, Compare, kArity>::empty() const noexcept {
+  return size_ == 0;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] typename Heap<T, Compare, kArity>::size_type
+Heap<T, Compare, kArity>::getSize() const noexcept {
+  return size_;
+}
+
+// Modifiers
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::push(const value_type& value) {
+  emplace(value);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::push(value_type&& value) {
+  emplace(std::move(value));
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+template <typename... Args>
+void Heap<T, Compare, kArity>::emplace(Args&&... args) {
+  emplaceBack(std::forward<Args>(args)...);
+  siftingUp(size_ - 1);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::pop() {
+  if (size_ == 0) {
+    throw std::length_error("Heap is empty");
+  }
+  --size_;
+  if (size_ > 0) {
+    data_[0] = std::move(data_[size_]);
+  }
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    (data_ + size_)->~value_type();
+  }
+  if (size_ > 0) {
+    siftingDown(0);
+  }
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+template <HeapSourceRange<T> Range>
+void Heap<T, Compare, kArity>::pushRange(Range&& range) {
+  if constexpr (std::ranges::sized_range<Range>) {
+    const auto range_size = static_cast<size_type>(std::ranges::size(range));
+    // Growing geometrically keeps repeated small batches linear
+    if (size_ + range_size > capacity_) {
+      reallocate(std::max(size_ + range_size, 2 * capacity_));
+    }
+  }
+  const size_type old_size = size_;
+  try {
+    for (auto&& value : range) {
+      if constexpr (kIsRangeMovable<Range>) {
+        emplaceBack(std::move(value));
+      } else {
+        emplaceBack(std::forward<decltype(value)>(value));
+      }
+    }
+  } catch (...) {
+    // The elements added before the exception stay in the heap
+    restoreHeap(old_size);
+    throw;
+  }
+  restoreHeap(old_size);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+template <typename OutputIterator>
+OutputIterator Heap<T, Compare, kArity>::popN(size_type count,
+                                              OutputIterator out) {
+  if (count > size_) {
+    throw std::length_error("Heap has less elements than requested");
+  }
+  for (; count > 0; --count) {
+    *out = std::move(data_[0]);
+    ++out;
+    pop();
+  }
+  return out;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::merge(Heap<T, Compare, kArity>&& other) {
+  if (this == &other) {
+    return;
+  }
+  // The smaller heap is moved into the larger one
+  if (other.size_ > size_) {
+    swap(other);
+  }
+  if (size_ + other.size_ > capacity_) {
+    reallocate(std::max(size_ + other.size_, 2 * capacity_));
+  }
+  const size_type old_size = size_;
+  for (size_type ind = 0; ind < other.size_; ++ind) {
+    new (data_ + size_) value_type(std::move(other.data_[ind]));
+    ++size_;
+  }
+  free(other.data_, other.size_);
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.capacity_ = 0;
+  restoreHeap(old_size);
+}
+
+// private
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::swap(
+    Heap<T, Compare, kArity>& other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::free(value_type* data_to_free,
+                                    size_type destructor_calls) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<value_type>) {
+    size_type destroyed_objects = 0;
+    while (destroyed_objects < destructor_calls) {
+      (data_to_free + destroyed_objects)->~value_type();
+      ++destroyed_objects;
+    }
+  }
+  ::operator delete(data_to_free);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::uninitializedCopy(
+    value_type* copy_to, const Heap<T, Compare, kArity>& copy_from) {
+  size_type copied_objects = 0;
+  try {
+    for (; copied_objects < copy_from.size_; ++copied_objects) {
+      new (copy_to + copied_objects)
+          value_type(copy_from.data_[copied_objects]);
+    }
+  } catch (...) {
+    free(copy_to, copied_objects);
+    throw;
+  }
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::uninitializedCopy(value_type* copy_to,
+                                                 const value_type* copy_from,
+                                                 size_type size) {
+  size_type copied_objects = 0;
+  try {
+    for (; copied_objects < size; ++copied_objects) {
+      new (copy_to + copied_objects) value_type(copy_from[copied_objects]);
+    }
+  } catch (...) {
+    free(copy_to, copied_objects);
+    throw;
+  }
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] typename Heap<T, Compare, kArity>::size_type
+Heap<T, Compare, kArity>::getFirstChild(size_type index) const noexcept {
+  return kArity * index + 1;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] typename Heap<T, Compare, kArity>::size_type
+Heap<T, Compare, kArity>::getParent(size_type index) const noexcept {
+  return (index - 1) / kArity;
+}
+
+// Returns the child which must be the parent of the others. A node with all
+// kArity children is scanned by a loop with a constant trip count and a
+// branchless body, so the compiler unrolls it and uses conditional moves
+// for arithmetic types
+template <typename T, typename Compare, std::size_t kArity>
+[[nodiscard]] typename Heap<T, Compare, kArity>::size_type
+Heap<T, Compare, kArity>::selectChild(size_type first_child) {
+  size_type selected_child = first_child;
+  if (first_child + kArity <= size_) {
+    for (size_type offset = 1; offset < kArity; ++offset) {
+      const size_type child = first_child + offset;
+      selected_child = comparator_(data_[child], data_[selected_child])
+                           ? child
+                           : selected_child;
+    }
+  } else {
+    for (size_type child = first_child + 1; child < size_; ++child) {
+      selected_child = comparator_(data_[child], data_[selected_child])
+                           ? child
+                           : selected_child;
+    }
+  }
+  return selected_child;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+template <typename... Args>
+void Heap<T, Compare, kArity>::emplaceBack(Args&&... args) {
+  if (size_ == capacity_) {
+    // args may refer to an element of the heap, so the value is created
+    // before the old data is released
+    value_type value(std::forward<Args>(args)...);
+    this->resize();
+    new (data_ + size_) value_type(std::move(value));
+  } else {
+    new (data_ + size_) value_type(std::forward<Args>(args)...);
+  }
+  ++size_;
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::resize() {
+  reallocate(capacity_ > 0 ? capacity_ * 2 : capacity_ + 1);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::reallocate(size_type new_capacity) {
+  value_type* new_data = reinterpret_cast<value_type*>(
+      ::operator new(sizeof(value_type) * new_capacity));
+  if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                !std::is_copy_constructible_v<value_type>) {
+    size_type moved_objects = 0;
+    while (moved_objects < size_) {
+      new (new_data + moved_objects)
+          value_type(std::move(data_[moved_objects]));
+      ++moved_objects;
+    }
+  } else {
+    uninitializedCopy(new_data, *this);
+  }
+  free(data_, size_);
+  data_ = new_data;
+  capacity_ = new_capacity;
+}
+
+// The element at index is held aside while the selected children move up
+// into the hole, so every level costs one move instead of a swap
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::siftingDown(size_type index) noexcept(
+    kIsNothrowSifting) {
+  value_type value = std::move(data_[index]);
+  size_type first_child = getFirstChild(index);
+  while (first_child < size_) {
+    const size_type selected_child = selectChild(first_child);
+    if (!comparator_(data_[selected_child], value)) {
+      break;
+    }
+    data_[index] = std::move(data_[selected_child]);
+    index = selected_child;
+    first_child = getFirstChild(index);
+  }
+  data_[index] = std::move(value);
+}
+
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::siftingUp(size_type index) noexcept(
+    kIsNothrowSifting) {
+  value_type value = std::move(data_[index]);
+  while (index > 0) {
+    const size_type parent = getParent(index);
+    if (!comparator_(value, data_[parent])) {
+      break;
+    }
+    data_[index] = std::move(data_[parent]);
+    index = parent;
+  }
+  data_[index] = std::move(value);
+}
+
+// Floyd's construction: sifts down every node which has children starting
+// from the last one, O(n) in total
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::makeHeap() noexcept(kIsNothrowSifting) {
+  if (size_ < 2) {
+    return;
+  }
+  for (size_type i = getParent(size_ - 1) + 1; i > 0; --i) {
+    siftingDown(i - 1);
+  }
+}
+
+// Restores the heap after elements were appended to the first old_size ones.
+// Sifting up each of k new elements costs up to k * log(n) comparisons and
+// rebuilding costs about 2n, the cheaper way is chosen
+template <typename T, typename Compare, std::size_t kArity>
+void Heap<T, Compare, kArity>::restoreHeap(size_type old_size) noexcept(
+    kIsNothrowSifting) {
+  const size_type added_count = size_ - old_size;
+  const auto height = static_cast<size_type>(std::bit_width(size_));
+  if (added_count * height > 2 * size_) {
+    makeHeap();
+    return;
+  }
+  for (size_type ind = old_size; ind < size_; ++ind) {
+    siftingUp(ind);
+  }
+}
+
 }  // namespace ads
 
 #endif  // CUSTOMADS_SRC_DATA_STRUCTURES_HEAP_HEAP_HEAP_HPP_
@@ -0,0 +1,85 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_ITERATIVE_SEGMENT_TREE_ITERATIVE_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_ITERATIVE_SEGMENT_TREE_ITERATIVE_SEGMENT_TREE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Bottom-up segment tree in an array of 2 * n elements: leaves are
+// segment_tree_[n, 2n), the parent of node i is i / 2. Queries and updates
+// are loops over the levels without recursion. The operator does not have
+// to be commutative, the left and right parts of a query are accumulated
+// separately
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class IterativeSegmentTree {
+public:
+  explicit IterativeSegmentTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()),
+        segment_tree_(2 * vec.size()) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    std::copy(vec.begin(), vec.end(),
+              segment_tree_.begin() + static_cast<std::ptrdiff_t>(vec_size_));
+    for (std::size_t tree_ind = vec_size_ - 1; tree_ind > 0; --tree_ind) {
+      segment_tree_[tree_ind] = bin_operation_(
+          segment_tree_[2 * tree_ind], segment_tree_[2 * tree_ind + 1]);
+    }
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    T left_result = kNeutralElement;
+    T right_result = kNeutralElement;
+    std::size_t tree_left = left + vec_size_;
+    std::size_t tree_right = right + vec_size_ + 1;
+    while (tree_left < tree_right) {
+      if ((tree_left & 1) != 0) {
+        left_result = bin_operation_(left_result, segment_tree_[tree_left++]);
+      }
+      if ((tree_right & 1) != 0) {
+        right_result =
+            bin_operation_(segment_tree_[--tree_right], right_result);
+      }
+      tree_left /= 2;
+      tree_right /= 2;
+    }
+    return bin_operation_(left_result, right_result);
+  }
+
+  void indexUpdate(const std::size_t& vec_ind, const T& new_vec_value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    std::size_t tree_ind = vec_ind + vec_size_;
+    segment_tree_[tree_ind] = new_vec_value;
+    for (tree_ind /= 2; tree_ind > 0; tree_ind /= 2) {
+      segment_tree_[tree_ind] = bin_operation_(
+          segment_tree_[2 * tree_ind], segment_tree_[2 * tree_ind + 1]);
+    }
+  }
+
+private:
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  std::vector<T> segment_tree_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_ITERATIVE_SEGMENT_TREE_ITERATIVE_SEGMENT_TREE_HPP_
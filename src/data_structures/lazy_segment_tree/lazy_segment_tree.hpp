@@ -0,0 +1,215 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_LAZY_SEGMENT_TREE_LAZY_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_LAZY_SEGMENT_TREE_LAZY_SEGMENT_TREE_HPP_
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Segment tree with lazy propagation: assignment of a value to a segment and
+// application of a tag to every element of a segment cost O(log n) like
+// segment queries. Pending updates of a node are kept until a later update
+// goes below it, queries take them into account without pushing
+template <typename T, typename Functor, T kNeutralElement, typename Tag,
+          typename Mapping>
+requires BinaryOperator<Functor, T> && TagMapping<Mapping, T, Tag> &&
+         std::is_copy_assignable_v<T> && std::is_copy_assignable_v<Tag>
+class LazySegmentTree {
+public:
+  explicit LazySegmentTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        mapping_(),
+        vec_size_(vec.size()),
+        segment_tree_(4 * vec.size()),
+        pending_(4 * vec.size()) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    build(vec, 0ULL, 0ULL, vec.size() - 1);
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    checkSegment(left, right);
+    return subtreeSegmentQuery(0ULL, 0ULL, vec_size_ - 1, left, right);
+  }
+
+  void indexUpdate(const std::size_t& vec_ind, const T& new_vec_value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    subtreeRangeUpdate(0ULL, 0ULL, vec_size_ - 1, vec_ind, vec_ind,
+                       PendingUpdate{.has_assign_ = true,
+                                     .assign_value_ = new_vec_value,
+                                     .has_tag_ = false,
+                                     .tag_ = Tag()});
+  }
+
+  // Assigns new_vec_value to all elements in [left, right]
+  void rangeAssign(const std::size_t& left, const std::size_t& right,
+                   const T& new_vec_value) {
+    checkSegment(left, right);
+    subtreeRangeUpdate(0ULL, 0ULL, vec_size_ - 1, left, right,
+                       PendingUpdate{.has_assign_ = true,
+                                     .assign_value_ = new_vec_value,
+                                     .has_tag_ = false,
+                                     .tag_ = Tag()});
+  }
+
+  // Applies tag to all elements in [left, right]
+  void rangeApply(const std::size_t& left, const std::size_t& right,
+                  const Tag& tag) {
+    checkSegment(left, right);
+    subtreeRangeUpdate(0ULL, 0ULL, vec_size_ - 1, left, right,
+                       PendingUpdate{.has_assign_ = false,
+                                     .assign_value_ = kNeutralElement,
+                                     .has_tag_ = true,
+                                     .tag_ = tag});
+  }
+
+private:
+  // An assignment followed by a tag is folded into a new assignment, so at
+  // most one of has_assign_ and has_tag_ is set
+  struct PendingUpdate {
+    bool has_assign_;
+    T assign_value_;
+    bool has_tag_;
+    Tag tag_;
+  };
+
+  void checkSegment(const std::size_t& left, const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+  }
+
+  void build(const std::vector<T>& base_array, const std::size_t& tree_ind,
+             const std::size_t& segment_left,
+             const std::size_t& segment_right) {
+    if (segment_left == segment_right) {
+      segment_tree_[tree_ind] = base_array[segment_left];
+    } else {
+      const std::size_t segment_middle = (segment_left + segment_right) / 2;
+      const std::size_t tree_left_ind = tree_ind * 2 + 1;
+      const std::size_t tree_right_ind = tree_ind * 2 + 2;
+      build(base_array, tree_left_ind, segment_left, segment_middle);
+      build(base_array, tree_right_ind, segment_middle + 1, segment_right);
+      segment_tree_[tree_ind] = bin_operation_(segment_tree_[tree_left_ind],
+                                               segment_tree_[tree_right_ind]);
+    }
+  }
+
+  // Value of the aggregate of size elements after update
+  [[nodiscard]] T updatedValue(const T& value, const PendingUpdate& update,
+                               const std::size_t size) const {
+    if (update.has_assign_) {
+      return mapping_.repeat(update.assign_value_, size);
+    }
+    if (update.has_tag_) {
+      return mapping_(value, update.tag_, size);
+    }
+    return value;
+  }
+
+  void applyUpdate(const std::size_t& tree_ind,
+                   const std::size_t& segment_size,
+                   const PendingUpdate& update) {
+    segment_tree_[tree_ind] =
+        updatedValue(segment_tree_[tree_ind], update, segment_size);
+    PendingUpdate& pending = pending_[tree_ind];
+    if (update.has_assign_) {
+      pending = update;
+    } else if (pending.has_assign_) {
+      pending.assign_value_ = mapping_(pending.assign_value_, update.tag_, 1);
+    } else if (pending.has_tag_) {
+      pending.tag_ = mapping_.compose(pending.tag_, update.tag_);
+    } else {
+      pending = update;
+    }
+  }
+
+  void push(const std::size_t& tree_ind, const std::size_t& segment_left,
+            const std::size_t& segment_middle,
+            const std::size_t& segment_right) {
+    PendingUpdate& pending = pending_[tree_ind];
+    if (!pending.has_assign_ && !pending.has_tag_) {
+      return;
+    }
+    applyUpdate(tree_ind * 2 + 1, segment_middle - segment_left + 1, pending);
+    applyUpdate(tree_ind * 2 + 2, segment_right - segment_middle, pending);
+    pending.has_assign_ = false;
+    pending.has_tag_ = false;
+  }
+
+  [[nodiscard]] T subtreeSegmentQuery(const std::size_t& tree_ind,
+                                      const std::size_t& segment_left,
+                                      const std::size_t& segment_right,
+                                      const std::size_t& query_left,
+                                      const std::size_t& query_right) const {
+    if (query_left > query_right) {
+      return kNeutralElement;
+    }
+    if ((segment_left == query_left) && (segment_right == query_right)) {
+      return segment_tree_[tree_ind];
+    }
+    if (pending_[tree_ind].has_assign_) {
+      return mapping_.repeat(pending_[tree_ind].assign_value_,
+                             query_right - query_left + 1);
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    const T children_value = bin_operation_(
+        subtreeSegmentQuery(tree_left_ind, segment_left, segment_middle,
+                            query_left, std::min(query_right, segment_middle)),
+        subtreeSegmentQuery(tree_right_ind, segment_middle + 1, segment_right,
+                            std::max(query_left, segment_middle + 1),
+                            query_right));
+    return updatedValue(children_value, pending_[tree_ind],
+                        query_right - query_left + 1);
+  }
+
+  void subtreeRangeUpdate(const std::size_t& tree_ind,
+                          const std::size_t& segment_left,
+                          const std::size_t& segment_right,
+                          const std::size_t& query_left,
+                          const std::size_t& query_right,
+                          const PendingUpdate& update) {
+    if (query_left > query_right) {
+      return;
+    }
+    if ((segment_left == query_left) && (segment_right == query_right)) {
+      applyUpdate(tree_ind, segment_right - segment_left + 1, update);
+      return;
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    push(tree_ind, segment_left, segment_middle, segment_right);
+    subtreeRangeUpdate(tree_left_ind, segment_left, segment_middle, query_left,
+                       std::min(query_right, segment_middle), update);
+    subtreeRangeUpdate(tree_right_ind, segment_middle + 1, segment_right,
+                       std::max(query_left, segment_middle + 1), query_right,
+                       update);
+    segment_tree_[tree_ind] = bin_operation_(segment_tree_[tree_left_ind],
+                                             segment_tree_[tree_right_ind]);
+  }
+
+  Functor bin_operation_;
+  Mapping mapping_;
+  std::size_t vec_size_;
+  std::vector<T> segment_tree_;
+  std::vector<PendingUpdate> pending_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_LAZY_SEGMENT_TREE_LAZY_SEGMENT_TREE_HPP_
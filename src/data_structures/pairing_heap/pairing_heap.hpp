@@ -0,0 +1,340 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_PAIRING_HEAP_PAIRING_HEAP_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_PAIRING_HEAP_PAIRING_HEAP_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ads {
+
+// Pairing heap with O(1) push and merge and amortized O(log n) pop. The
+// nodes are kept in a Pool, one vector of nodes linked by indices with a
+// free list of released nodes. Heaps created with the same pool are merged
+// by linking their roots, merging heaps with different pools moves the
+// nodes of the other heap one by one. A pool is not synchronized, heaps
+// which share it must be used from one thread. Compare(a, b) is true when a
+// must be closer to the top than b, like in Heap
+template <typename T, typename Compare>
+class PairingHeap {
+  struct Node {
+    std::optional<T> value_;
+    std::uint32_t child_;
+    // Next child of the parent, or the next free node in the pool
+    std::uint32_t sibling_;
+  };
+
+  static constexpr std::uint32_t kNoNode =
+      std::numeric_limits<std::uint32_t>::max();
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using value_compare = Compare;
+  using const_reference = const T&;
+
+  class Pool {
+  public:
+    Pool()
+        : nodes_(),
+          free_node_(kNoNode) {}
+
+    [[nodiscard]] size_type nodesCount() const noexcept {
+      return nodes_.size();
+    }
+
+  private:
+    friend class PairingHeap<T, Compare>;
+
+    template <typename... Args>
+    std::uint32_t allocate(Args&&... args) {
+      if (free_node_ != kNoNode) {
+        const std::uint32_t node = free_node_;
+        const std::uint32_t next_free_node = nodes_[node].sibling_;
+        nodes_[node].value_.emplace(std::forward<Args>(args)...);
+        nodes_[node].child_ = kNoNode;
+        nodes_[node].sibling_ = kNoNode;
+        free_node_ = next_free_node;
+        return node;
+      }
+      if (nodes_.size() >= kNoNode) {
+        throw std::length_error("Too many pairing heap nodes");
+      }
+      // args may refer to a node, so the value is created before the nodes
+      // are reallocated
+      T value(std::forward<Args>(args)...);
+      nodes_.push_back(Node{.value_ = std::move(value),
+                            .child_ = kNoNode,
+                            .sibling_ = kNoNode});
+      return static_cast<std::uint32_t>(nodes_.size() - 1);
+    }
+
+    void release(const std::uint32_t& node) noexcept {
+      nodes_[node].value_.reset();
+      nodes_[node].child_ = kNoNode;
+      nodes_[node].sibling_ = free_node_;
+      free_node_ = node;
+    }
+
+    std::vector<Node> nodes_;
+    std::uint32_t free_node_;
+  };
+
+  PairingHeap()
+      : pool_(std::make_shared<Pool>()),
+        root_(kNoNode),
+        size_(0),
+        comparator_() {}
+
+  explicit PairingHeap(std::shared_ptr<Pool> pool)
+      : pool_(std::move(pool)),
+        root_(kNoNode),
+        size_(0),
+        comparator_() {
+    if (pool_ == nullptr) {
+      throw std::invalid_argument("Pool of the heap must not be null");
+    }
+  }
+
+  // The copy shares the pool of other
+  PairingHeap(const PairingHeap<T, Compare>& other)
+      : pool_(other.pool_),
+        root_(kNoNode),
+        size_(0),
+        comparator_(other.comparator_) {
+    try {
+      pushTree(other, other.root_);
+    } catch (...) {
+      releaseTree(root_);
+      throw;
+    }
+  }
+
+  PairingHeap<T, Compare>& operator=(const PairingHeap<T, Compare>& other) {
+    if (this != &other) {
+      PairingHeap<T, Compare> copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  // other stays usable and keeps its pool
+  PairingHeap(PairingHeap<T, Compare>&& other) noexcept
+      : pool_(other.pool_),
+        root_(std::exchange(other.root_, kNoNode)),
+        size_(std::exchange(other.size_, 0)),
+        comparator_(std::move(other.comparator_)) {}
+
+  PairingHeap<T, Compare>& operator=(
+      PairingHeap<T, Compare>&& other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  ~PairingHeap() {
+    releaseTree(root_);
+  }
+
+  // Element access
+  [[nodiscard]] const_reference top() const {
+    if (root_ == kNoNode) {
+      throw std::length_error("Heap is empty");
+    }
+    return *pool_->nodes_[root_].value_;
+  }
+
+  // Capacity
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_type getSize() const noexcept {
+    return size_;
+  }
+
+  [[nodiscard]] const std::shared_ptr<Pool>& getPool() const noexcept {
+    return pool_;
+  }
+
+  // Modifiers
+  void push(const value_type& value) {
+    emplace(value);
+  }
+
+  void push(value_type&& value) {
+    emplace(std::move(value));
+  }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    const std::uint32_t node = pool_->allocate(std::forward<Args>(args)...);
+    root_ = (root_ == kNoNode) ? node : link(root_, node);
+    ++size_;
+  }
+
+  void pop() {
+    if (root_ == kNoNode) {
+      throw std::length_error("Heap is empty");
+    }
+    const std::uint32_t old_root = root_;
+    root_ = mergePairs(node(old_root).child_);
+    pool_->release(old_root);
+    --size_;
+  }
+
+  // Moves all elements of other to the heap, other becomes empty. O(1) when
+  // both heaps use the same pool, O(m) for m elements of other otherwise
+  void merge(PairingHeap<T, Compare>&& other) {
+    if ((this == &other) || (other.root_ == kNoNode)) {
+      return;
+    }
+    if (pool_ != other.pool_) {
+      other.moveTo(*this);
+      return;
+    }
+    root_ = (root_ == kNoNode) ? other.root_ : link(root_, other.root_);
+    size_ += other.size_;
+    other.root_ = kNoNode;
+    other.size_ = 0;
+  }
+
+private:
+  [[nodiscard]] Node& node(const std::uint32_t& node_ind) noexcept {
+    return pool_->nodes_[node_ind];
+  }
+
+  void swap(PairingHeap<T, Compare>& other) noexcept {
+    std::swap(pool_, other.pool_);
+    std::swap(root_, other.root_);
+    std::swap(size_, other.size_);
+    std::swap(comparator_, other.comparator_);
+  }
+
+  // Makes the root which must be lower the first child of the other one.
+  // Both nodes must be roots without siblings
+  [[nodiscard]] std::uint32_t link(std::uint32_t first,
+                                   std::uint32_t second) {
+    if (comparator_(*node(second).value_, *node(first).value_)) {
+      std::swap(first, second);
+    }
+    node(second).sibling_ = node(first).child_;
+    node(first).child_ = second;
+    return first;
+  }
+
+  // Two-pass pairing of the list of children starting at first: the
+  // children are linked in pairs from left to right, then the pairs are
+  // linked from right to left. The first pass collects the pairs in reverse
+  // order through the sibling links, so no extra memory is needed
+  [[nodiscard]] std::uint32_t mergePairs(std::uint32_t first) {
+    std::uint32_t pairs = kNoNode;
+    while (first != kNoNode) {
+      const std::uint32_t second = node(first).sibling_;
+      if (second == kNoNode) {
+        node(first).sibling_ = pairs;
+        pairs = first;
+        break;
+      }
+      const std::uint32_t next = node(second).sibling_;
+      node(first).sibling_ = kNoNode;
+      node(second).sibling_ = kNoNode;
+      const std::uint32_t pair = link(first, second);
+      node(pair).sibling_ = pairs;
+      pairs = pair;
+      first = next;
+    }
+    std::uint32_t root = kNoNode;
+    while (pairs != kNoNode) {
+      const std::uint32_t next = node(pairs).sibling_;
+      node(pairs).sibling_ = kNoNode;
+      root = (root == kNoNode) ? pairs : link(root, pairs);
+      pairs = next;
+    }
+    return root;
+  }
+
+  // Visits the nodes of a tree without a stack by rotating the first child
+  // of the current node above it until the current node has no children,
+  // the child and sibling links are used like the left and right links of
+  // a binary tree. The tree is destroyed in the process
+  template <typename Visitor>
+  void consumeTree(std::uint32_t current, Visitor&& visitor) {
+    while (current != kNoNode) {
+      const std::uint32_t child = node(current).child_;
+      if (child == kNoNode) {
+        const std::uint32_t next = node(current).sibling_;
+        visitor(current);
+        current = next;
+      } else {
+        node(current).child_ = node(child).sibling_;
+        node(child).sibling_ = current;
+        current = child;
+      }
+    }
+  }
+
+  void releaseTree(const std::uint32_t& root) noexcept {
+    consumeTree(root, [this](const std::uint32_t& node_ind) {
+      pool_->release(node_ind);
+    });
+  }
+
+  // Copies the values of the tree of other which starts at root
+  void pushTree(const PairingHeap<T, Compare>& other,
+                const std::uint32_t& root) {
+    std::vector<std::uint32_t> nodes_to_visit;
+    if (root != kNoNode) {
+      nodes_to_visit.push_back(root);
+    }
+    while (!nodes_to_visit.empty()) {
+      const std::uint32_t node_ind = nodes_to_visit.back();
+      nodes_to_visit.pop_back();
+      const Node& other_node = other.pool_->nodes_[node_ind];
+      if (other_node.sibling_ != kNoNode) {
+        nodes_to_visit.push_back(other_node.sibling_);
+      }
+      if (other_node.child_ != kNoNode) {
+        nodes_to_visit.push_back(other_node.child_);
+      }
+      // Copying into the same pool may reallocate its nodes
+      T value = *other_node.value_;
+      push(std::move(value));
+    }
+  }
+
+  // Moves the values to heap, which uses another pool, and empties this
+  // heap. If a push throws, the values which were not moved yet are dropped
+  // and the exception is rethrown after all nodes return to the pool
+  void moveTo(PairingHeap<T, Compare>& heap) {
+    const std::uint32_t root = std::exchange(root_, kNoNode);
+    size_ = 0;
+    std::exception_ptr error;
+    consumeTree(root, [this, &heap, &error](const std::uint32_t& node_ind) {
+      if (error == nullptr) {
+        try {
+          heap.push(std::move(*node(node_ind).value_));
+        } catch (...) {
+          error = std::current_exception();
+        }
+      }
+      pool_->release(node_ind);
+    });
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::shared_ptr<Pool> pool_;
+  std::uint32_t root_;
+  size_type size_;
+  Compare comparator_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_PAIRING_HEAP_PAIRING_HEAP_HPP_
@@ -0,0 +1,217 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_PERSISTENT_SEGMENT_TREE_PERSISTENT_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_PERSISTENT_SEGMENT_TREE_PERSISTENT_SEGMENT_TREE_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Segment tree that keeps every version: indexUpdate copies the path from
+// the root to the leaf, O(log n) nodes, and returns the number of the new
+// version, the other nodes are shared with the updated version. Nodes are
+// allocated one after another in a single vector and refer to children by
+// 32-bit indices. Nodes of versions that are no longer needed are freed all
+// at once by compact
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class PersistentSegmentTree {
+public:
+  // Version 0 holds vec
+  explicit PersistentSegmentTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    nodes_.reserve(2 * vec.size() - 1);
+    roots_.push_back(build(vec, 0ULL, vec.size() - 1));
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& version,
+                               const std::size_t& left,
+                               const std::size_t& right) const {
+    checkVersion(version);
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    return subtreeSegmentQuery(roots_[version], 0ULL, vec_size_ - 1, left,
+                               right);
+  }
+
+  // Creates a version equal to version with new_vec_value at vec_ind,
+  // returns its number
+  std::size_t indexUpdate(const std::size_t& version,
+                          const std::size_t& vec_ind, const T& new_vec_value) {
+    checkVersion(version);
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    const std::uint32_t root = subtreeIndexUpdate(
+        roots_[version], 0ULL, vec_size_ - 1, vec_ind, new_vec_value);
+    roots_.push_back(root);
+    return roots_.size() - 1;
+  }
+
+  // Number of created versions including the removed ones
+  [[nodiscard]] std::size_t versionsCount() const noexcept {
+    return roots_.size();
+  }
+
+  [[nodiscard]] bool hasVersion(const std::size_t& version) const noexcept {
+    return (version < roots_.size()) && (roots_[version] != kNoNode);
+  }
+
+  [[nodiscard]] std::size_t nodesCount() const noexcept {
+    return nodes_.size();
+  }
+
+  // Removes all versions except kept_versions and moves their nodes to a new
+  // pool, shared nodes stay shared. Numbers of kept versions do not change
+  void compact(const std::vector<std::size_t>& kept_versions) {
+    for (const std::size_t version : kept_versions) {
+      checkVersion(version);
+    }
+    std::vector<std::uint32_t> new_node_ind(nodes_.size(), kNoNode);
+    std::vector<Node> new_nodes;
+    std::vector<std::uint32_t> new_roots(roots_.size(), kNoNode);
+    for (const std::size_t version : kept_versions) {
+      new_roots[version] = copyReachable(roots_[version], new_node_ind,
+                                         new_nodes);
+    }
+    new_nodes.shrink_to_fit();
+    nodes_ = std::move(new_nodes);
+    roots_ = std::move(new_roots);
+  }
+
+private:
+  static constexpr std::uint32_t kNoNode =
+      std::numeric_limits<std::uint32_t>::max();
+
+  struct Node {
+    T value_;
+    std::uint32_t left_child_;
+    std::uint32_t right_child_;
+  };
+
+  void checkVersion(const std::size_t& version) const {
+    if (!hasVersion(version)) {
+      throw std::range_error("Version does not exist");
+    }
+  }
+
+  std::uint32_t allocate(const Node& node) {
+    if (nodes_.size() >= kNoNode) {
+      throw std::length_error("Too many segment tree nodes");
+    }
+    nodes_.push_back(node);
+    return static_cast<std::uint32_t>(nodes_.size() - 1);
+  }
+
+  std::uint32_t build(const std::vector<T>& base_array,
+                      const std::size_t& segment_left,
+                      const std::size_t& segment_right) {
+    if (segment_left == segment_right) {
+      return allocate(Node{.value_ = base_array[segment_left],
+                           .left_child_ = kNoNode,
+                           .right_child_ = kNoNode});
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::uint32_t left_child =
+        build(base_array, segment_left, segment_middle);
+    const std::uint32_t right_child =
+        build(base_array, segment_middle + 1, segment_right);
+    return allocate(Node{.value_ = bin_operation_(nodes_[left_child].value_,
+                                                  nodes_[right_child].value_),
+                         .left_child_ = left_child,
+                         .right_child_ = right_child});
+  }
+
+  [[nodiscard]] T subtreeSegmentQuery(const std::uint32_t& node,
+                                      const std::size_t& segment_left,
+                                      const std::size_t& segment_right,
+                                      const std::size_t& query_left,
+                                      const std::size_t& query_right) const {
+    if (query_left > query_right) {
+      return kNeutralElement;
+    }
+    if ((segment_left == query_left) && (segment_right == query_right)) {
+      return nodes_[node].value_;
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    return bin_operation_(
+        subtreeSegmentQuery(nodes_[node].left_child_, segment_left,
+                            segment_middle, query_left,
+                            std::min(query_right, segment_middle)),
+        subtreeSegmentQuery(nodes_[node].right_child_, segment_middle + 1,
+                            segment_right,
+                            std::max(query_left, segment_middle + 1),
+                            query_right));
+  }
+
+  std::uint32_t subtreeIndexUpdate(const std::uint32_t& node,
+                                   const std::size_t& segment_left,
+                                   const std::size_t& segment_right,
+                                   const std::size_t& vec_ind,
+                                   const T& new_vec_value) {
+    if (segment_left == segment_right) {
+      return allocate(Node{.value_ = new_vec_value,
+                           .left_child_ = kNoNode,
+                           .right_child_ = kNoNode});
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    std::uint32_t left_child = nodes_[node].left_child_;
+    std::uint32_t right_child = nodes_[node].right_child_;
+    if (vec_ind <= segment_middle) {
+      left_child = subtreeIndexUpdate(left_child, segment_left, segment_middle,
+                                      vec_ind, new_vec_value);
+    } else {
+      right_child = subtreeIndexUpdate(right_child, segment_middle + 1,
+                                       segment_right, vec_ind, new_vec_value);
+    }
+    return allocate(Node{.value_ = bin_operation_(nodes_[left_child].value_,
+                                                  nodes_[right_child].value_),
+                         .left_child_ = left_child,
+                         .right_child_ = right_child});
+  }
+
+  // Copies the subtree of node to new_nodes unless it is already copied,
+  // returns the index of the copy
+  std::uint32_t copyReachable(const std::uint32_t& node,
+                              std::vector<std::uint32_t>& new_node_ind,
+                              std::vector<Node>& new_nodes) const {
+    if (new_node_ind[node] != kNoNode) {
+      return new_node_ind[node];
+    }
+    Node copy = nodes_[node];
+    if (copy.left_child_ != kNoNode) {
+      copy.left_child_ =
+          copyReachable(copy.left_child_, new_node_ind, new_nodes);
+      copy.right_child_ =
+          copyReachable(copy.right_child_, new_node_ind, new_nodes);
+    }
+    new_nodes.push_back(copy);
+    new_node_ind[node] = static_cast<std::uint32_t>(new_nodes.size() - 1);
+    return new_node_ind[node];
+  }
+
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  std::vector<Node> nodes_;
+  // Root node of every version or kNoNode for removed versions
+  std::vector<std::uint32_t> roots_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_PERSISTENT_SEGMENT_TREE_PERSISTENT_SEGMENT_TREE_HPP_
@@ -0,0 +1,129 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_RADIX_HEAP_RADIX_HEAP_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_RADIX_HEAP_RADIX_HEAP_HPP_
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace ads {
+
+// Min-heap of unsigned keys for monotone workloads: a pushed key must not be
+// less than the last popped one. Bucket i > 0 holds the keys whose highest
+// bit differing from the last popped key is bit i - 1, bucket 0 holds the
+// keys equal to it. pop takes keys from bucket 0 and refills it from the
+// first non-empty bucket, every key moves to a lower bucket at most
+// std::numeric_limits<T>::digits times, so pop is amortized O(log C)
+template <std::unsigned_integral T>
+class RadixHeap {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using const_reference = const T&;
+
+  RadixHeap()
+      : buckets_(),
+        bucket_mins_(),
+        non_empty_buckets_(0),
+        last_popped_(0),
+        size_(0) {
+    bucket_mins_.fill(std::numeric_limits<T>::max());
+  }
+
+  // Element access
+  [[nodiscard]] const_reference top() const {
+    if (size_ == 0) {
+      throw std::length_error("Heap is empty");
+    }
+    if (!buckets_[0].empty()) {
+      return last_popped_;
+    }
+    return bucket_mins_[firstNonEmptyBucket()];
+  }
+
+  // Capacity
+  [[nodiscard]] bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  [[nodiscard]] size_type getSize() const noexcept {
+    return size_;
+  }
+
+  // Modifiers
+  void push(const value_type& value) {
+    if (value < last_popped_) {
+      throw std::invalid_argument(
+          "Pushed key must not be less than the last popped one");
+    }
+    pushToBucket(value);
+    ++size_;
+  }
+
+  void pop() {
+    if (size_ == 0) {
+      throw std::length_error("Heap is empty");
+    }
+    if (buckets_[0].empty()) {
+      refill();
+    }
+    buckets_[0].pop_back();
+    --size_;
+  }
+
+private:
+  static constexpr std::size_t kBucketsCount =
+      std::numeric_limits<T>::digits + 1;
+
+  [[nodiscard]] static std::size_t bucketIndex(const value_type& value,
+                                               const value_type& last_popped) {
+    return static_cast<std::size_t>(std::bit_width(
+        static_cast<value_type>(value ^ last_popped)));
+  }
+
+  // Bit i - 1 of non_empty_buckets_ is set when bucket i > 0 has keys
+  [[nodiscard]] std::size_t firstNonEmptyBucket() const noexcept {
+    return static_cast<std::size_t>(std::countr_zero(non_empty_buckets_)) + 1;
+  }
+
+  void pushToBucket(const value_type& value) {
+    const std::size_t bucket = bucketIndex(value, last_popped_);
+    buckets_[bucket].push_back(value);
+    if (bucket > 0) {
+      non_empty_buckets_ |= std::uint64_t{1} << (bucket - 1);
+      if (value < bucket_mins_[bucket]) {
+        bucket_mins_[bucket] = value;
+      }
+    }
+  }
+
+  // Makes the minimum of the first non-empty bucket the new base, the keys
+  // of the bucket spread over the lower buckets and its minimum goes to
+  // bucket 0. The buckets above keep their keys
+  void refill() {
+    const std::size_t bucket = firstNonEmptyBucket();
+    last_popped_ = bucket_mins_[bucket];
+    for (const value_type& value : buckets_[bucket]) {
+      pushToBucket(value);
+    }
+    buckets_[bucket].clear();
+    bucket_mins_[bucket] = std::numeric_limits<T>::max();
+    non_empty_buckets_ &= ~(std::uint64_t{1} << (bucket - 1));
+  }
+
+  // The vectors keep their capacity after refill, so a steady workload stops
+  // allocating
+  std::array<std::vector<value_type>, kBucketsCount> buckets_;
+  std::array<value_type, kBucketsCount> bucket_mins_;
+  std::uint64_t non_empty_buckets_;
+  value_type last_popped_;
+  size_type size_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_RADIX_HEAP_RADIX_HEAP_HPP_
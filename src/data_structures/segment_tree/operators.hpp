@@ -0,0 +1,39 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_OPERATORS_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_OPERATORS_HPP_
+
+#include <algorithm>
+
+namespace ads {
+
+// Operators for which segment trees may use specialized implementations.
+// User-defined functors with the same behaviour work, but are treated as
+// arbitrary operators
+
+template <typename T>
+struct Sum {
+  T operator()(const T& left, const T& right) const noexcept {
+    return left + right;
+  }
+};
+
+template <typename T>
+struct Min {
+  static constexpr bool kIsIdempotent = true;
+
+  T operator()(const T& left, const T& right) const noexcept {
+    return std::min(left, right);
+  }
+};
+
+template <typename T>
+struct Max {
+  static constexpr bool kIsIdempotent = true;
+
+  T operator()(const T& left, const T& right) const noexcept {
+    return std::max(left, right);
+  }
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_OPERATORS_HPP_
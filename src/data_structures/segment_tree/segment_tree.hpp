@@ -1,7 +1,14 @@
 #ifndef CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_SEGMENT_TREE_HPP_
 #define CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_SEGMENT_TREE_HPP_
 
+#include <algorithm>
+#include <concepts>
+#include <iterator>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <type_traits>
 
@@ -13,20 +20,65 @@ concept BinaryOperator =
       { func_obj(arg1, arg2) } -> std::same_as<ArgType>;
     };
 
-// TODO add methods:
-// 1. To assign new_value to all elements in segment_tree_[left, ..., right]
+// Idempotent operators, func_obj(arg, arg) == arg, declare it with a member
+// static constexpr bool kIsIdempotent = true or by a specialization of
+// IsIdempotent
+template <typename Functor>
+struct IsIdempotent
+    : std::bool_constant<requires { requires Functor::kIsIdempotent; }> {};
+
+template <typename Functor, typename ArgType>
+concept IdempotentOperator =
+    BinaryOperator<Functor, ArgType> && IsIdempotent<Functor>::value;
+
+// Mapping describes how a range update tag acts on aggregated values:
+// mapping(value, tag, size) is the aggregate of size elements with the
+// aggregate value after tag is applied to every element,
+// mapping.compose(first, second) is the tag equal to first applied before
+// second, mapping.repeat(value, size) is the aggregate of size copies of value
+template <typename Mapping, typename ArgType, typename TagType>
+concept TagMapping = requires(Mapping mapping, ArgType arg, TagType tag1,
+                              TagType tag2, std::size_t size) {
+  { mapping(arg, tag1, size) } -> std::same_as<ArgType>;
+  { mapping.compose(tag1, tag2) } -> std::same_as<TagType>;
+  { mapping.repeat(arg, size) } -> std::same_as<ArgType>;
+};
+
+// LazySegmentTree supports updates of whole segments.
+// The constructors, segmentQueries and applyUpdates run on one thread by
+// default. With threads_count > 1 Functor is called from several threads at
+// once, so it must be safe to call concurrently
 template <typename T, typename Functor, T kNeutralElement>
 requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
 class SegmentTree {
 public:
-  explicit SegmentTree(const std::vector<T>& vec)
+  // The build splits into subtrees processed by up to threads_count threads,
+  // each with at least kMinBuildElementsPerThread elements
+  explicit SegmentTree(const std::vector<T>& vec,
+                       const std::size_t& threads_count = 1)
       : bin_operation_(),
         vec_size_(vec.size()),
         segment_tree_(4 * vec.size()) {
-    if (vec.empty()) {
-      throw std::runtime_error("Base vector must be non empty");
-    }
-    build(vec, 0ULL, 0ULL, vec.size() - 1);
+    buildFrom(vec.begin(), threads_count);
+  }
+
+  // The elements of vec are moved to the tree
+  explicit SegmentTree(std::vector<T>&& vec,
+                       const std::size_t& threads_count = 1)
+      : bin_operation_(),
+        vec_size_(vec.size()),
+        segment_tree_(4 * vec.size()) {
+    buildFrom(std::make_move_iterator(vec.begin()), threads_count);
+  }
+
+  template <std::ranges::forward_range Range>
+  requires std::ranges::sized_range<Range> &&
+           std::convertible_to<std::ranges::range_reference_t<Range>, T>
+  explicit SegmentTree(Range&& range, const std::size_t& threads_count = 1)
+      : bin_operation_(),
+        vec_size_(static_cast<std::size_t>(std::ranges::size(range))),
+        segment_tree_(4 * vec_size_) {
+    buildFrom(std::ranges::begin(range), threads_count);
   }
 
   [[nodiscard]] T segmentQuery(const std::size_t& left,
@@ -48,18 +100,264 @@ public:
     subtreeIndexUpdate(0ULL, 0ULL, vec_size_ - 1, vec_ind, new_vec_value);
   }
 
+  // answers[i] = segmentQuery(queries[i].first, queries[i].second), the
+  // queries are split between threads_count threads
+  void segmentQueries(
+      std::span<const std::pair<std::size_t, std::size_t>> queries,
+      std::span<T> answers, std::size_t threads_count = 1) const {
+    if (answers.size() < queries.size()) {
+      throw std::invalid_argument("Not enough space for the answers");
+    }
+    for (const auto& [left, right] : queries) {
+      if (left > right) {
+        throw std::range_error(
+            "Left index of the query must be not greater than right one");
+      }
+      if (right >= vec_size_) {
+        throw std::range_error("The segment exceeds the size of the vector");
+      }
+    }
+    const auto answer_chunk = [&](const std::size_t& begin,
+                                  const std::size_t& end) {
+      for (std::size_t ind = begin; ind < end; ++ind) {
+        answers[ind] = subtreeSegmentQuery(0ULL, 0ULL, vec_size_ - 1,
+                                           queries[ind].first,
+                                           queries[ind].second);
+      }
+    };
+    threads_count = std::clamp<std::size_t>(
+        std::min(threads_count, queries.size() / kMinTasksPerThread), 1,
+        kMaxThreadsCount);
+    const std::size_t chunk_size =
+        (queries.size() + threads_count - 1) / threads_count;
+    std::vector<std::jthread> threads;
+    threads.reserve(threads_count - 1);
+    for (std::size_t thread_ind = 1; thread_ind < threads_count;
+         ++thread_ind) {
+      threads.emplace_back(answer_chunk, thread_ind * chunk_size,
+                           std::min((thread_ind + 1) * chunk_size,
+                                    queries.size()));
+    }
+    answer_chunk(0ULL, std::min(chunk_size, queries.size()));
+  }
+
+  // Sets the values of all updates, the last one wins for equal indices.
+  // Every affected node is recomputed once after its children, subtrees
+  // with updates on both sides are processed by different threads
+  void applyUpdates(std::span<const std::pair<std::size_t, T>> updates,
+                    std::size_t threads_count = 1) {
+    for (const auto& update : updates) {
+      if (update.first >= vec_size_) {
+        throw std::range_error("Index exceeds the size of the vector");
+      }
+    }
+    if (updates.empty()) {
+      return;
+    }
+    std::vector<std::pair<std::size_t, T>> sorted_updates(updates.begin(),
+                                                          updates.end());
+    std::stable_sort(sorted_updates.begin(), sorted_updates.end(),
+                     [](const auto& first, const auto& second) {
+                       return first.first < second.first;
+                     });
+    std::size_t unique_count = 0;
+    for (std::size_t ind = 0; ind < sorted_updates.size(); ++ind) {
+      if ((ind + 1 < sorted_updates.size()) &&
+          (sorted_updates[ind + 1].first == sorted_updates[ind].first)) {
+        continue;
+      }
+      sorted_updates[unique_count++] = std::move(sorted_updates[ind]);
+    }
+    sorted_updates.resize(unique_count);
+    // Neighbouring elements of std::vector<bool> share memory
+    if constexpr (std::is_same_v<T, bool>) {
+      threads_count = 1;
+    }
+    subtreeApplyUpdates(0ULL, 0ULL, vec_size_ - 1, sorted_updates,
+                        std::min(threads_count, kMaxThreadsCount));
+  }
+
+  // The first index right >= left such that pred(aggregate of [left, right])
+  // is false or the size of the vector if there is none. pred must hold for
+  // kNeutralElement and stay false once it is false for a segment
+  template <typename Predicate>
+  requires std::predicate<Predicate&, const T&>
+  [[nodiscard]] std::size_t maxRight(const std::size_t& left,
+                                     Predicate pred) const {
+    if (left > vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    checkPredicate(pred);
+    T aggregate = kNeutralElement;
+    return subtreeMaxRight(0ULL, 0ULL, vec_size_ - 1, left, pred, aggregate);
+  }
+
+  // The least index left <= right + 1 such that pred(aggregate of
+  // [left, right]) holds, the aggregate of [right + 1, right] is
+  // kNeutralElement. pred must hold for kNeutralElement and stay false once
+  // it is false for a segment
+  template <typename Predicate>
+  requires std::predicate<Predicate&, const T&>
+  [[nodiscard]] std::size_t minLeft(const std::size_t& right,
+                                    Predicate pred) const {
+    if (right >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    checkPredicate(pred);
+    T aggregate = kNeutralElement;
+    return subtreeMinLeft(0ULL, 0ULL, vec_size_ - 1, right, pred, aggregate);
+  }
+
 private:
-  void build(const std::vector<T>& base_array, const std::size_t& tree_ind,
+  // Batches smaller than that are not worth starting a thread
+  static constexpr std::size_t kMinTasksPerThread = 1024;
+  // Building a leaf is much cheaper than a query, a thread needs this many
+  // elements to pay for its start
+  static constexpr std::size_t kMinBuildElementsPerThread = 1ULL << 16;
+  static constexpr std::size_t kMaxThreadsCount = 256;
+
+  template <typename Predicate>
+  static void checkPredicate(Predicate& pred) {
+    if (!pred(kNeutralElement)) {
+      throw std::invalid_argument(
+          "Predicate must hold for the neutral element");
+    }
+  }
+
+  // Returns the answer of maxRight in [segment_left, segment_right] or
+  // segment_right + 1 if pred holds up to segment_right, aggregate is
+  // extended with the checked elements
+  template <typename Predicate>
+  [[nodiscard]] std::size_t subtreeMaxRight(const std::size_t& tree_ind,
+                                            const std::size_t& segment_left,
+                                            const std::size_t& segment_right,
+                                            const std::size_t& query_left,
+                                            Predicate& pred,
+                                            T& aggregate) const {
+    if (segment_right < query_left) {
+      return segment_right + 1;
+    }
+    if (query_left <= segment_left) {
+      T extended_aggregate = bin_operation_(aggregate, segment_tree_[tree_ind]);
+      if (pred(extended_aggregate)) {
+        aggregate = std::move(extended_aggregate);
+        return segment_right + 1;
+      }
+      if (segment_left == segment_right) {
+        return segment_left;
+      }
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    const std::size_t left_result =
+        subtreeMaxRight(tree_left_ind, segment_left, segment_middle,
+                        query_left, pred, aggregate);
+    if (left_result <= segment_middle) {
+      return left_result;
+    }
+    return subtreeMaxRight(tree_right_ind, segment_middle + 1, segment_right,
+                           query_left, pred, aggregate);
+  }
+
+  // Returns the answer of minLeft in [segment_left + 1, segment_right + 1]
+  // or segment_left if pred holds down to segment_left, aggregate is
+  // extended with the checked elements
+  template <typename Predicate>
+  [[nodiscard]] std::size_t subtreeMinLeft(const std::size_t& tree_ind,
+                                           const std::size_t& segment_left,
+                                           const std::size_t& segment_right,
+                                           const std::size_t& query_right,
+                                           Predicate& pred,
+                                           T& aggregate) const {
+    if (segment_left > query_right) {
+      return segment_left;
+    }
+    if (segment_right <= query_right) {
+      T extended_aggregate = bin_operation_(segment_tree_[tree_ind], aggregate);
+      if (pred(extended_aggregate)) {
+        aggregate = std::move(extended_aggregate);
+        return segment_left;
+      }
+      if (segment_left == segment_right) {
+        return segment_left + 1;
+      }
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    const std::size_t right_result =
+        subtreeMinLeft(tree_right_ind, segment_middle + 1, segment_right,
+                       query_right, pred, aggregate);
+    if (right_result > segment_middle + 1) {
+      return right_result;
+    }
+    return subtreeMinLeft(tree_left_ind, segment_left, segment_middle,
+                          query_right, pred, aggregate);
+  }
+
+  template <typename Iterator>
+  void buildFrom(const Iterator& first, const std::size_t& threads_count) {
+    if (vec_size_ == 0) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    // Leaves of std::vector<bool> can not be written concurrently
+    if constexpr (std::is_same_v<T, bool>) {
+      parallelBuild(first, 0ULL, 0ULL, vec_size_ - 1, 1);
+    } else {
+      parallelBuild(first, 0ULL, 0ULL, vec_size_ - 1,
+                    std::min(threads_count, kMaxThreadsCount));
+    }
+  }
+
+  // Leaves of the recursive layout lie on different levels, so the tree is
+  // built by subtrees: the left subtree of a node is given to a new thread
+  // while it has enough elements and threads
+  template <typename Iterator>
+  void parallelBuild(const Iterator& first, const std::size_t& tree_ind,
+                     const std::size_t& segment_left,
+                     const std::size_t& segment_right,
+                     const std::size_t& threads_count) {
+    if ((threads_count <= 1) ||
+        (segment_right - segment_left + 1 < 2 * kMinBuildElementsPerThread)) {
+      Iterator current = first;
+      build(current, tree_ind, segment_left, segment_right);
+      return;
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    const std::size_t left_threads_count = threads_count / 2;
+    {
+      std::jthread left_thread([&] {
+        parallelBuild(first, tree_left_ind, segment_left, segment_middle,
+                      left_threads_count);
+      });
+      parallelBuild(
+          std::next(first, static_cast<std::iter_difference_t<Iterator>>(
+                               segment_middle + 1 - segment_left)),
+          tree_right_ind, segment_middle + 1, segment_right,
+          threads_count - left_threads_count);
+    }
+    segment_tree_[tree_ind] = bin_operation_(segment_tree_[tree_left_ind],
+                                             segment_tree_[tree_right_ind]);
+  }
+
+  // current points to the element at segment_left and is moved past
+  // segment_right
+  template <typename Iterator>
+  void build(Iterator& current, const std::size_t& tree_ind,
              const std::size_t& segment_left,
              const std::size_t& segment_right) {
     if (segment_left == segment_right) {
-      segment_tree_[tree_ind] = base_array[segment_left];
+      segment_tree_[tree_ind] = *current;
+      ++current;
     } else {
       const std::size_t segment_middle = (segment_left + segment_right) / 2;
       const std::size_t tree_left_ind = tree_ind * 2 + 1;
       const std::size_t tree_right_ind = tree_ind * 2 + 2;
-      build(base_array, tree_left_ind, segment_left, segment_middle);
-      build(base_array, tree_right_ind, segment_middle + 1, segment_right);
+      build(current, tree_left_ind, segment_left, segment_middle);
+      build(current, tree_right_ind, segment_middle + 1, segment_right);
       segment_tree_[tree_ind] = bin_operation_(segment_tree_[tree_left_ind],
                                                segment_tree_[tree_right_ind]);
     }
@@ -109,6 +407,48 @@ private:
                                              segment_tree_[tree_right_ind]);
   }
 
+  // updates are sorted by index without repetitions and lie in the segment
+  void subtreeApplyUpdates(const std::size_t& tree_ind,
+                           const std::size_t& segment_left,
+                           const std::size_t& segment_right,
+                           std::span<const std::pair<std::size_t, T>> updates,
+                           const std::size_t& threads_count) {
+    if (updates.empty()) {
+      return;
+    }
+    if (segment_left == segment_right) {
+      segment_tree_[tree_ind] = updates.front().second;
+      return;
+    }
+    const std::size_t segment_middle = (segment_left + segment_right) / 2;
+    const std::size_t tree_left_ind = tree_ind * 2 + 1;
+    const std::size_t tree_right_ind = tree_ind * 2 + 2;
+    const auto split = std::partition_point(
+        updates.begin(), updates.end(),
+        [&](const auto& update) { return update.first <= segment_middle; });
+    const std::span<const std::pair<std::size_t, T>> left_updates(
+        updates.begin(), split);
+    const std::span<const std::pair<std::size_t, T>> right_updates(
+        split, updates.end());
+    if ((threads_count > 1) && !left_updates.empty() &&
+        !right_updates.empty() && (updates.size() >= kMinTasksPerThread)) {
+      const std::size_t left_threads_count = threads_count / 2;
+      std::jthread left_thread([&] {
+        subtreeApplyUpdates(tree_left_ind, segment_left, segment_middle,
+                            left_updates, left_threads_count);
+      });
+      subtreeApplyUpdates(tree_right_ind, segment_middle + 1, segment_right,
+                          right_updates, threads_count - left_threads_count);
+    } else {
+      subtreeApplyUpdates(tree_left_ind, segment_left, segment_middle,
+                          left_updates, threads_count);
+      subtreeApplyUpdates(tree_right_ind, segment_middle + 1, segment_right,
+                          right_updates, threads_count);
+    }
+    segment_tree_[tree_ind] = bin_operation_(segment_tree_[tree_left_ind],
+                                             segment_tree_[tree_right_ind]);
+  }
+
   Functor bin_operation_;
   std::size_t vec_size_;
   std::vector<T> segment_tree_;
@@ -0,0 +1,158 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_2D_SEGMENT_TREE_2D_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_2D_SEGMENT_TREE_2D_HPP_
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Bottom-up segment tree of bottom-up segment trees for an n x m matrix,
+// stored row by row in one array of 2n x 2m elements. Row node i of the
+// outer tree holds the column tree of the aggregates of its rows, the
+// leaves of both trees start at n and m like in IterativeSegmentTree.
+// rectangleQuery and indexUpdate are O(log n * log m). Elements of a
+// rectangle are combined in no particular order, so the operator must be
+// commutative
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class SegmentTree2D {
+public:
+  explicit SegmentTree2D(const std::vector<std::vector<T>>& matrix)
+      : bin_operation_(),
+        rows_count_(matrix.size()),
+        columns_count_(matrix.empty() ? 0 : matrix.front().size()),
+        segment_tree_(4 * rows_count_ * columns_count_) {
+    if (segment_tree_.empty()) {
+      throw std::runtime_error("Base matrix must be non empty");
+    }
+    for (std::size_t row = 0; row < rows_count_; ++row) {
+      if (matrix[row].size() != columns_count_) {
+        throw std::invalid_argument("Rows of the matrix must have equal size");
+      }
+      T* tree_row = rowTree(row + rows_count_);
+      for (std::size_t column = 0; column < columns_count_; ++column) {
+        tree_row[column + columns_count_] = matrix[row][column];
+      }
+      for (std::size_t tree_ind = columns_count_ - 1; tree_ind > 0;
+           --tree_ind) {
+        tree_row[tree_ind] =
+            bin_operation_(tree_row[2 * tree_ind], tree_row[2 * tree_ind + 1]);
+      }
+    }
+    for (std::size_t tree_row_ind = rows_count_ - 1; tree_row_ind > 0;
+         --tree_row_ind) {
+      T* tree_row = rowTree(tree_row_ind);
+      const T* left_row = rowTree(2 * tree_row_ind);
+      const T* right_row = rowTree(2 * tree_row_ind + 1);
+      for (std::size_t tree_ind = 1; tree_ind < 2 * columns_count_;
+           ++tree_ind) {
+        tree_row[tree_ind] =
+            bin_operation_(left_row[tree_ind], right_row[tree_ind]);
+      }
+    }
+  }
+
+  // Aggregate of the rows [top, bottom] and the columns [left, right]
+  [[nodiscard]] T rectangleQuery(const std::size_t& top,
+                                 const std::size_t& bottom,
+                                 const std::size_t& left,
+                                 const std::size_t& right) const {
+    if ((top > bottom) || (left > right)) {
+      throw std::range_error(
+          "First index of the query must be not greater than last one");
+    }
+    if ((bottom >= rows_count_) || (right >= columns_count_)) {
+      throw std::range_error("The rectangle exceeds the size of the matrix");
+    }
+    T result = kNeutralElement;
+    std::size_t tree_top = top + rows_count_;
+    std::size_t tree_bottom = bottom + rows_count_ + 1;
+    while (tree_top < tree_bottom) {
+      if ((tree_top & 1) != 0) {
+        result = bin_operation_(result, rowQuery(tree_top++, left, right));
+      }
+      if ((tree_bottom & 1) != 0) {
+        result = bin_operation_(result, rowQuery(--tree_bottom, left, right));
+      }
+      tree_top /= 2;
+      tree_bottom /= 2;
+    }
+    return result;
+  }
+
+  void indexUpdate(const std::size_t& row, const std::size_t& column,
+                   const T& new_value) {
+    if ((row >= rows_count_) || (column >= columns_count_)) {
+      throw std::range_error("Index exceeds the size of the matrix");
+    }
+    std::size_t tree_row_ind = row + rows_count_;
+    T* tree_row = rowTree(tree_row_ind);
+    std::size_t tree_ind = column + columns_count_;
+    tree_row[tree_ind] = new_value;
+    for (tree_ind /= 2; tree_ind > 0; tree_ind /= 2) {
+      tree_row[tree_ind] =
+          bin_operation_(tree_row[2 * tree_ind], tree_row[2 * tree_ind + 1]);
+    }
+    for (tree_row_ind /= 2; tree_row_ind > 0; tree_row_ind /= 2) {
+      tree_row = rowTree(tree_row_ind);
+      const T* left_row = rowTree(2 * tree_row_ind);
+      const T* right_row = rowTree(2 * tree_row_ind + 1);
+      for (tree_ind = column + columns_count_; tree_ind > 0; tree_ind /= 2) {
+        tree_row[tree_ind] =
+            bin_operation_(left_row[tree_ind], right_row[tree_ind]);
+      }
+    }
+  }
+
+  [[nodiscard]] std::size_t rowsCount() const noexcept {
+    return rows_count_;
+  }
+
+  [[nodiscard]] std::size_t columnsCount() const noexcept {
+    return columns_count_;
+  }
+
+private:
+  [[nodiscard]] T* rowTree(const std::size_t& tree_row_ind) noexcept {
+    return segment_tree_.data() + tree_row_ind * 2 * columns_count_;
+  }
+
+  [[nodiscard]] const T* rowTree(
+      const std::size_t& tree_row_ind) const noexcept {
+    return segment_tree_.data() + tree_row_ind * 2 * columns_count_;
+  }
+
+  // Aggregate of the columns [left, right] in the column tree of a row node
+  [[nodiscard]] T rowQuery(const std::size_t& tree_row_ind,
+                           const std::size_t& left,
+                           const std::size_t& right) const {
+    const T* tree_row = rowTree(tree_row_ind);
+    T result = kNeutralElement;
+    std::size_t tree_left = left + columns_count_;
+    std::size_t tree_right = right + columns_count_ + 1;
+    while (tree_left < tree_right) {
+      if ((tree_left & 1) != 0) {
+        result = bin_operation_(result, tree_row[tree_left++]);
+      }
+      if ((tree_right & 1) != 0) {
+        result = bin_operation_(result, tree_row[--tree_right]);
+      }
+      tree_left /= 2;
+      tree_right /= 2;
+    }
+    return result;
+  }
+
+  Functor bin_operation_;
+  std::size_t rows_count_;
+  std::size_t columns_count_;
+  std::vector<T> segment_tree_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_SEGMENT_TREE_2D_SEGMENT_TREE_2D_HPP_
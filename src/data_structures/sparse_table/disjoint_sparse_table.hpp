@@ -0,0 +1,85 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_DISJOINT_SPARSE_TABLE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_DISJOINT_SPARSE_TABLE_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Static table for any associative operator. Level k splits the indices
+// into blocks of 2^(k + 1) elements and stores for every index the
+// aggregate from it to the middle of its block. The highest differing bit
+// of left and right selects the level where they lie in different halves of
+// one block, so a query combines two disjoint parts. Build is O(n log n),
+// segmentQuery is O(1)
+template <typename T, typename Functor>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class DisjointSparseTable {
+public:
+  explicit DisjointSparseTable(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()),
+        levels_count_(std::max<std::size_t>(
+            1, static_cast<std::size_t>(std::bit_width(vec.size() - 1)))) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    table_.resize(levels_count_ * vec_size_, vec[0]);
+    for (std::size_t level = 0; level < levels_count_; ++level) {
+      const std::size_t half_size = std::size_t{1} << level;
+      T* level_table = table_.data() + level * vec_size_;
+      for (std::size_t block_begin = 0; block_begin < vec_size_;
+           block_begin += 2 * half_size) {
+        const std::size_t middle =
+            std::min(block_begin + half_size, vec_size_);
+        const std::size_t block_end =
+            std::min(block_begin + 2 * half_size, vec_size_);
+        level_table[middle - 1] = vec[middle - 1];
+        for (std::size_t ind = middle - 1; ind > block_begin; --ind) {
+          level_table[ind - 1] = bin_operation_(vec[ind - 1], level_table[ind]);
+        }
+        if (middle == block_end) {
+          continue;
+        }
+        level_table[middle] = vec[middle];
+        for (std::size_t ind = middle + 1; ind < block_end; ++ind) {
+          level_table[ind] = bin_operation_(level_table[ind - 1], vec[ind]);
+        }
+      }
+    }
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    if (left == right) {
+      return table_[left];
+    }
+    const auto level =
+        static_cast<std::size_t>(std::bit_width(left ^ right)) - 1;
+    const std::size_t level_begin = level * vec_size_;
+    return bin_operation_(table_[level_begin + left],
+                          table_[level_begin + right]);
+  }
+
+private:
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  std::size_t levels_count_;
+  std::vector<T> table_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_DISJOINT_SPARSE_TABLE_HPP_
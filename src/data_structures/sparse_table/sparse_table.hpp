@@ -0,0 +1,69 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_SPARSE_TABLE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_SPARSE_TABLE_HPP_
+
+#include <bit>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+// Static table of aggregates of all segments of power of two lengths:
+// level k holds the aggregates of [i, i + 2^k). A query combines two
+// overlapping segments, so the operator must be idempotent. Build is
+// O(n log n), segmentQuery is O(1)
+template <typename T, typename Functor>
+requires IdempotentOperator<Functor, T> && std::is_copy_assignable_v<T>
+class SparseTable {
+public:
+  explicit SparseTable(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()),
+        levels_count_(static_cast<std::size_t>(std::bit_width(vec.size()))) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    table_.reserve(levels_count_ * vec_size_);
+    table_.insert(table_.end(), vec.begin(), vec.end());
+    for (std::size_t level = 1; level < levels_count_; ++level) {
+      const std::size_t half_size = std::size_t{1} << (level - 1);
+      const std::size_t prev_level_begin = (level - 1) * vec_size_;
+      for (std::size_t ind = 0; ind + 2 * half_size <= vec_size_; ++ind) {
+        table_.push_back(
+            bin_operation_(table_[prev_level_begin + ind],
+                           table_[prev_level_begin + ind + half_size]));
+      }
+      // Segments that do not fit are never queried
+      table_.resize((level + 1) * vec_size_, vec[0]);
+    }
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    const auto level =
+        static_cast<std::size_t>(std::bit_width(right - left + 1)) - 1;
+    const std::size_t level_begin = level * vec_size_;
+    return bin_operation_(
+        table_[level_begin + left],
+        table_[level_begin + right + 1 - (std::size_t{1} << level)]);
+  }
+
+private:
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  std::size_t levels_count_;
+  std::vector<T> table_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_SPARSE_TABLE_SPARSE_TABLE_HPP_
@@ -0,0 +1,325 @@
+#ifndef CUSTOMADS_SRC_DATA_STRUCTURES_WIDE_SEGMENT_TREE_WIDE_SEGMENT_TREE_HPP_
+#define CUSTOMADS_SRC_DATA_STRUCTURES_WIDE_SEGMENT_TREE_WIDE_SEGMENT_TREE_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../segment_tree/operators.hpp"
+#include "../segment_tree/segment_tree.hpp"
+
+namespace ads {
+
+enum class WideSegmentTreeOperation { kGeneric, kSum, kMin, kMax };
+
+// Lane by lane operations on blocks of kBlockSize values of arithmetic type
+// T with vector extensions of GCC and Clang. A vector is as wide as the
+// widest enabled vector registers, a block takes one or more vectors
+template <typename T, std::size_t kBlockSize,
+          WideSegmentTreeOperation kOperation>
+struct WideSegmentTreeLanes {
+#if defined(__AVX512F__)
+  static constexpr std::size_t kVectorBytes = 64;
+#elif defined(__AVX__)
+  static constexpr std::size_t kVectorBytes = 32;
+#else
+  static constexpr std::size_t kVectorBytes = 16;
+#endif
+  static constexpr std::size_t kLanes =
+      std::min(kBlockSize, kVectorBytes / sizeof(T));
+
+  // Signed integer type of the size of T, vector comparisons of T give
+  // vectors of it
+  using lane_type = std::conditional_t<
+      sizeof(T) == 1, std::int8_t,
+      std::conditional_t<sizeof(T) == 2, std::int16_t,
+                         std::conditional_t<sizeof(T) == 4, std::int32_t,
+                                            std::int64_t>>>;
+  typedef T values_type __attribute__((vector_size(kLanes * sizeof(T))));
+  typedef lane_type mask_type __attribute__((vector_size(kLanes * sizeof(T))));
+  typedef std::make_unsigned_t<lane_type> unsigned_values_type
+      __attribute__((vector_size(kLanes * sizeof(T))));
+
+  [[nodiscard]] static values_type broadcast(const T value) noexcept {
+    values_type values;
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      values[lane] = value;
+    }
+    return values;
+  }
+
+  [[nodiscard]] static values_type combine(
+      const values_type& left, const values_type& right) noexcept {
+    if constexpr ((kOperation == WideSegmentTreeOperation::kSum) &&
+                  std::is_integral_v<T>) {
+      // Signed lanes are added as unsigned ones, so an overflow wraps like
+      // the scalar sum of promoted values instead of being undefined
+      return std::bit_cast<values_type>(
+          std::bit_cast<unsigned_values_type>(left) +
+          std::bit_cast<unsigned_values_type>(right));
+    } else if constexpr (kOperation == WideSegmentTreeOperation::kSum) {
+      return left + right;
+    } else if constexpr (kOperation == WideSegmentTreeOperation::kMin) {
+      return (right < left) ? right : left;
+    } else {
+      return (left < right) ? right : left;
+    }
+  }
+
+  // Combines block[first_lane, ..., last_lane] into accumulated lane by lane
+  static void accumulate(values_type& accumulated, const T* block,
+                         const T neutral, const std::size_t first_lane,
+                         const std::size_t last_lane) noexcept {
+    for (std::size_t chunk_begin = 0; chunk_begin < kBlockSize;
+         chunk_begin += kLanes) {
+      values_type chunk;
+      std::memcpy(&chunk, block + chunk_begin, sizeof(chunk));
+      mask_type lane_indices;
+      mask_type first_lanes;
+      mask_type last_lanes;
+      for (std::size_t lane = 0; lane < kLanes; ++lane) {
+        lane_indices[lane] = static_cast<lane_type>(chunk_begin + lane);
+        first_lanes[lane] = static_cast<lane_type>(first_lane);
+        last_lanes[lane] = static_cast<lane_type>(last_lane);
+      }
+      accumulated = combine(
+          accumulated,
+          ((lane_indices >= first_lanes) & (lane_indices <= last_lanes))
+              ? chunk
+              : broadcast(neutral));
+    }
+  }
+
+  // Combines the upper half of the lanes with the lower one until a single
+  // lane is left
+  [[nodiscard]] static T reduce(values_type values, const T neutral) noexcept {
+    for (std::size_t width = kLanes / 2; width > 0; width /= 2) {
+      values_type upper_values = broadcast(neutral);
+      std::memcpy(&upper_values,
+                  reinterpret_cast<const char*>(&values) + width * sizeof(T),
+                  width * sizeof(T));
+      values = combine(values, upper_values);
+    }
+    return values[0];
+  }
+};
+
+// Segment tree with kBranching children per node. Every node is a block of
+// kBranching values that fills a cache line for 4 and 8 byte types: level 0
+// holds the elements, the value number i of level k + 1 is the aggregate of
+// the block number i of level k. Levels are stored from the root down, so
+// nodes are in breadth-first (Eytzinger) order: the children of the block
+// number i of a level are the blocks [i * kBranching, (i + 1) * kBranching)
+// of the level below, and the top levels visited by every operation share
+// cache lines and pages. A query visits at most two blocks per level, an
+// update one block per level.
+// For arithmetic T with ads::Sum, ads::Min, ads::Max or std::plus the blocks
+// of a query are combined lane by lane with vector extensions and reduced to
+// a single value once at the end. Other operators are applied element by
+// element
+template <typename T, typename Functor, T kNeutralElement>
+requires BinaryOperator<Functor, T> && std::is_copy_assignable_v<T>
+class WideSegmentTree {
+public:
+  static constexpr std::size_t kBranching = (sizeof(T) <= 4) ? 16 : 8;
+
+  explicit WideSegmentTree(const std::vector<T>& vec)
+      : bin_operation_(),
+        vec_size_(vec.size()) {
+    if (vec.empty()) {
+      throw std::runtime_error("Base vector must be non empty");
+    }
+    std::vector<std::size_t> level_sizes;
+    std::size_t level_size = vec_size_;
+    do {
+      level_size = (level_size + kBranching - 1) / kBranching;
+      level_sizes.push_back(level_size);
+    } while (level_size > 1);
+    level_begin_.resize(level_sizes.size());
+    std::size_t blocks_count = 0;
+    for (std::size_t level = level_sizes.size(); level-- > 0;) {
+      level_begin_[level] = blocks_count;
+      blocks_count += level_sizes[level];
+    }
+    blocks_.assign(blocks_count, neutralBlock());
+    for (std::size_t vec_ind = 0; vec_ind < vec_size_; ++vec_ind) {
+      value(0, vec_ind) = vec[vec_ind];
+    }
+    for (std::size_t level = 1; level < level_begin_.size(); ++level) {
+      for (std::size_t block = 0; block < level_sizes[level - 1]; ++block) {
+        value(level, block) = reduceBlock(level - 1, block);
+      }
+    }
+  }
+
+  [[nodiscard]] T segmentQuery(const std::size_t& left,
+                               const std::size_t& right) const {
+    if (left > right) {
+      throw std::range_error(
+          "Left index of the query must be not greater than right one");
+    }
+    if (right >= vec_size_) {
+      throw std::range_error("The segment exceeds the size of the vector");
+    }
+    if constexpr (kIsVectorized) {
+      auto result = lanes::broadcast(kNeutralElement);
+      visitQueryBlocks(left, right,
+                       [&](const Block& block, const std::size_t first_lane,
+                           const std::size_t last_lane) {
+                         lanes::accumulate(result, block.values_,
+                                           kNeutralElement, first_lane,
+                                           last_lane);
+                       });
+      return lanes::reduce(result, kNeutralElement);
+    } else {
+      T left_result = kNeutralElement;
+      T right_result = kNeutralElement;
+      visitQueryBlocks(
+          left, right,
+          [&](const Block& block, const std::size_t first_lane,
+              const std::size_t last_lane, const bool is_left_block) {
+            T block_result = kNeutralElement;
+            for (std::size_t lane = first_lane; lane <= last_lane; ++lane) {
+              block_result = bin_operation_(block_result, block.values_[lane]);
+            }
+            if (is_left_block) {
+              left_result = bin_operation_(left_result, block_result);
+            } else {
+              right_result = bin_operation_(block_result, right_result);
+            }
+          });
+      return bin_operation_(left_result, right_result);
+    }
+  }
+
+  void indexUpdate(const std::size_t& vec_ind, const T& new_vec_value) {
+    if (vec_ind >= vec_size_) {
+      throw std::range_error("Index exceeds the size of the vector");
+    }
+    if constexpr (kIsVectorized && std::is_integral_v<T> &&
+                  (kOperation == WideSegmentTreeOperation::kSum)) {
+      // Wrapping of the difference cancels out in every ancestor
+      using unsigned_type = std::make_unsigned_t<T>;
+      const auto delta = static_cast<unsigned_type>(
+          static_cast<unsigned_type>(new_vec_value) -
+          static_cast<unsigned_type>(value(0, vec_ind)));
+      std::size_t ind = vec_ind;
+      for (std::size_t level = 0; level < level_begin_.size(); ++level) {
+        T& ancestor_value = value(level, ind);
+        ancestor_value = static_cast<T>(
+            static_cast<unsigned_type>(ancestor_value) + delta);
+        ind /= kBranching;
+      }
+    } else {
+      value(0, vec_ind) = new_vec_value;
+      std::size_t block = vec_ind / kBranching;
+      for (std::size_t level = 1; level < level_begin_.size(); ++level) {
+        value(level, block) = reduceBlock(level - 1, block);
+        block /= kBranching;
+      }
+    }
+  }
+
+private:
+  static constexpr WideSegmentTreeOperation kOperation =
+      (std::is_same_v<Functor, Sum<T>> || std::is_same_v<Functor, std::plus<T>>)
+          ? WideSegmentTreeOperation::kSum
+      : std::is_same_v<Functor, Min<T>> ? WideSegmentTreeOperation::kMin
+      : std::is_same_v<Functor, Max<T>> ? WideSegmentTreeOperation::kMax
+                                        : WideSegmentTreeOperation::kGeneric;
+
+  static constexpr bool kIsVectorized =
+      (kOperation != WideSegmentTreeOperation::kGeneric) &&
+      std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+      ((sizeof(T) == 1) || (sizeof(T) == 2) || (sizeof(T) == 4) ||
+       (sizeof(T) == 8));
+
+  static constexpr std::size_t kBlockAlignment =
+      std::clamp(std::bit_ceil(kBranching * sizeof(T)), alignof(T),
+                 std::size_t{64});
+
+  // Only instantiated if kIsVectorized
+  using lanes = WideSegmentTreeLanes<T, kBranching, kOperation>;
+
+  struct alignas(kBlockAlignment) Block {
+    T values_[kBranching];
+  };
+
+  [[nodiscard]] static Block neutralBlock() {
+    Block block;
+    std::fill(block.values_, block.values_ + kBranching, kNeutralElement);
+    return block;
+  }
+
+  [[nodiscard]] T& value(const std::size_t level, const std::size_t ind) {
+    return blocks_[level_begin_[level] + ind / kBranching]
+        .values_[ind % kBranching];
+  }
+
+  // Calls visit_block(block, first_lane, last_lane[, is_left_block]) for
+  // the parts of blocks that cover [left, right]. Left blocks are visited
+  // from left to right, right blocks from right to left
+  template <typename Visitor>
+  void visitQueryBlocks(std::size_t left, std::size_t right,
+                        Visitor&& visit_block) const {
+    const auto visit = [&](const Block& block, const std::size_t first_lane,
+                           const std::size_t last_lane,
+                           const bool is_left_block) {
+      if constexpr (kIsVectorized) {
+        visit_block(block, first_lane, last_lane);
+      } else {
+        visit_block(block, first_lane, last_lane, is_left_block);
+      }
+    };
+    for (std::size_t level = 0;; ++level) {
+      const std::size_t left_block = left / kBranching;
+      const std::size_t right_block = right / kBranching;
+      const Block* level_blocks = blocks_.data() + level_begin_[level];
+      if (left_block == right_block) {
+        visit(level_blocks[left_block], left % kBranching, right % kBranching,
+              true);
+        return;
+      }
+      visit(level_blocks[left_block], left % kBranching, kBranching - 1, true);
+      visit(level_blocks[right_block], 0, right % kBranching, false);
+      if (left_block + 1 == right_block) {
+        return;
+      }
+      left = left_block + 1;
+      right = right_block - 1;
+    }
+  }
+
+  // Aggregate of the block number block of level
+  [[nodiscard]] T reduceBlock(const std::size_t level,
+                              const std::size_t block) const {
+    const Block& level_block = blocks_[level_begin_[level] + block];
+    if constexpr (kIsVectorized) {
+      auto result = lanes::broadcast(kNeutralElement);
+      lanes::accumulate(result, level_block.values_, kNeutralElement, 0,
+                        kBranching - 1);
+      return lanes::reduce(result, kNeutralElement);
+    } else {
+      T result = kNeutralElement;
+      for (const T& block_value : level_block.values_) {
+        result = bin_operation_(result, block_value);
+      }
+      return result;
+    }
+  }
+
+  Functor bin_operation_;
+  std::size_t vec_size_;
+  // Index of the first block of every level in blocks_
+  std::vector<std::size_t> level_begin_;
+  std::vector<Block> blocks_;
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_DATA_STRUCTURES_WIDE_SEGMENT_TREE_WIDE_SEGMENT_TREE_HPP_
@@ -0,0 +1,29 @@
+#ifndef CUSTOMADS_SRC_UNITTESTS_AFFINE_HPP_
+#define CUSTOMADS_SRC_UNITTESTS_AFFINE_HPP_
+
+#include <cstdint>
+
+namespace ads {
+
+// x -> x * mul_ + add_ modulo kModulo, composition is not commutative
+struct Affine {
+  static constexpr std::int64_t kModulo = 1'000'000'007;
+
+  std::int64_t mul_;
+  std::int64_t add_;
+
+  bool operator==(const Affine& other) const = default;
+};
+
+// Composition of maps, left one is applied first
+struct Compose {
+  Affine operator()(const Affine& first, const Affine& second) const noexcept {
+    return Affine{.mul_ = first.mul_ * second.mul_ % Affine::kModulo,
+                  .add_ = (first.add_ * second.mul_ + second.add_) %
+                          Affine::kModulo};
+  }
+};
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_UNITTESTS_AFFINE_HPP_
@@ -0,0 +1,191 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <queue>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/addressable_heap/addressable_heap.hpp"
+
+template <std::size_t kArity>
+void expectSameAsMultiset(const std::uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  ads::AddressableHeap<int, std::less<int>, kArity> heap;
+  std::multiset<int> expected_values;
+  std::map<std::size_t, int> values_by_handle;
+  for (std::size_t step = 0; step < 10000; ++step) {
+    const std::size_t operation = gen() % 6;
+    if ((operation == 0) || values_by_handle.empty()) {
+      const int value = value_dist(gen);
+      const std::size_t handle = heap.push(value);
+      EXPECT_FALSE(values_by_handle.contains(handle));
+      values_by_handle[handle] = value;
+      expected_values.insert(value);
+    } else if (operation == 1) {
+      const std::size_t handle = heap.topHandle();
+      expected_values.erase(expected_values.find(heap.top()));
+      values_by_handle.erase(handle);
+      heap.pop();
+      EXPECT_FALSE(heap.contains(handle));
+    } else {
+      auto it = values_by_handle.begin();
+      std::advance(it, gen() % values_by_handle.size());
+      const auto [handle, value] = *it;
+      EXPECT_EQ(heap.value(handle), value);
+      expected_values.erase(expected_values.find(value));
+      if (operation == 2) {
+        heap.erase(handle);
+        EXPECT_FALSE(heap.contains(handle));
+        values_by_handle.erase(it);
+        continue;
+      }
+      int new_value = value_dist(gen);
+      if (operation == 3) {
+        new_value = std::min(new_value, value);
+        heap.decreaseKey(handle, new_value);
+      } else if (operation == 4) {
+        new_value = std::max(new_value, value);
+        heap.increaseKey(handle, new_value);
+      } else {
+        heap.update(handle, new_value);
+      }
+      it->second = new_value;
+      expected_values.insert(new_value);
+    }
+    EXPECT_EQ(heap.getSize(), expected_values.size());
+    if (!expected_values.empty()) {
+      EXPECT_EQ(heap.top(), *expected_values.begin());
+      EXPECT_EQ(values_by_handle.at(heap.topHandle()), heap.top());
+    }
+  }
+}
+
+TEST(AddressableHeap, SameAsMultiset) {
+  expectSameAsMultiset<2>(48);
+  expectSameAsMultiset<3>(49);
+  expectSameAsMultiset<4>(50);
+}
+
+TEST(AddressableHeap, ThrowError) {
+  ads::AddressableHeap<int, std::less<int>> heap;
+  EXPECT_THROW(static_cast<void>(heap.top()), std::length_error);
+  EXPECT_THROW(static_cast<void>(heap.topHandle()), std::length_error);
+  EXPECT_THROW(heap.pop(), std::length_error);
+  EXPECT_THROW(static_cast<void>(heap.value(0)), std::range_error);
+  const std::size_t handle = heap.push(5);
+  heap.push(7);
+  EXPECT_THROW(heap.decreaseKey(handle, 6), std::invalid_argument);
+  EXPECT_THROW(heap.increaseKey(handle, 4), std::invalid_argument);
+  EXPECT_EQ(heap.value(handle), 5);
+  heap.decreaseKey(handle, 5);
+  heap.increaseKey(handle, 5);
+  heap.erase(handle);
+  EXPECT_THROW(heap.erase(handle), std::range_error);
+  EXPECT_THROW(heap.update(handle, 1), std::range_error);
+  EXPECT_THROW(heap.update(100, 1), std::range_error);
+  EXPECT_EQ(heap.top(), 7);
+}
+
+TEST(AddressableHeap, ReuseHandles) {
+  ads::AddressableHeap<std::string, std::greater<std::string>> heap;
+  const std::size_t first = heap.push(std::string(20, 'a'));
+  const std::size_t second = heap.emplace(20ULL, 'b');
+  const std::size_t third = heap.push("c");
+  EXPECT_EQ(heap.top(), "c");
+  heap.erase(first);
+  heap.pop();
+  EXPECT_FALSE(heap.contains(first));
+  EXPECT_FALSE(heap.contains(third));
+  EXPECT_TRUE(heap.contains(second));
+  // Freed handles are reused before new ones are created
+  const std::size_t fourth = heap.push(heap.value(second));
+  const std::size_t fifth = heap.push("d");
+  EXPECT_TRUE((fourth == first) || (fourth == third));
+  EXPECT_TRUE((fifth == first) || (fifth == third));
+  EXPECT_NE(fourth, fifth);
+  EXPECT_EQ(heap.value(fourth), std::string(20, 'b'));
+  EXPECT_EQ(heap.topHandle(), fifth);
+  heap.clear();
+  EXPECT_TRUE(heap.empty());
+  EXPECT_FALSE(heap.contains(second));
+  EXPECT_EQ(heap.push("e"), 0ULL);
+}
+
+// Dijkstra with decreaseKey must give the same distances as the version
+// which pushes duplicates into std::priority_queue
+TEST(AddressableHeap, ShortestPaths) {
+  const std::size_t vertices_count = 500;
+  std::mt19937 gen(51);
+  std::vector<std::vector<std::pair<std::size_t, std::int64_t>>> graph(
+      vertices_count);
+  for (std::size_t edge = 0; edge < 5000; ++edge) {
+    graph[gen() % vertices_count].emplace_back(gen() % vertices_count,
+                                               gen() % 1000);
+  }
+  const std::int64_t kInfinity = std::numeric_limits<std::int64_t>::max();
+
+  std::vector<std::int64_t> expected(vertices_count, kInfinity);
+  std::priority_queue<std::pair<std::int64_t, std::size_t>,
+                      std::vector<std::pair<std::int64_t, std::size_t>>,
+                      std::greater<>>
+      queue;
+  expected[0] = 0;
+  queue.emplace(0, 0);
+  while (!queue.empty()) {
+    const auto [distance, vertex] = queue.top();
+    queue.pop();
+    if (distance != expected[vertex]) {
+      continue;
+    }
+    for (const auto& [next, weight] : graph[vertex]) {
+      if (distance + weight < expected[next]) {
+        expected[next] = distance + weight;
+        queue.emplace(expected[next], next);
+      }
+    }
+  }
+
+  std::vector<std::int64_t> distances(vertices_count, kInfinity);
+  std::vector<std::size_t> handles(vertices_count);
+  std::vector<bool> is_queued(vertices_count, false);
+  ads::AddressableHeap<std::pair<std::int64_t, std::size_t>, std::less<>, 4>
+      heap;
+  distances[0] = 0;
+  handles[0] = heap.emplace(0, 0ULL);
+  is_queued[0] = true;
+  std::size_t max_size = 0;
+  while (!heap.empty()) {
+    max_size = std::max(max_size, heap.getSize());
+    const auto [distance, vertex] = heap.top();
+    heap.pop();
+    is_queued[vertex] = false;
+    for (const auto& [next, weight] : graph[vertex]) {
+      if (distance + weight >= distances[next]) {
+        continue;
+      }
+      distances[next] = distance + weight;
+      if (is_queued[next]) {
+        heap.decreaseKey(handles[next], {distances[next], next});
+      } else {
+        handles[next] = heap.emplace(distances[next], next);
+        is_queued[next] = true;
+      }
+    }
+  }
+  EXPECT_EQ(distances, expected);
+  EXPECT_LE(max_size, vertices_count);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,11 +1,20 @@
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <gtest/gtest.h>
 
 #include "data_structures/aho_corasick_automata/aho_corasick_automata.hpp"
+#include "data_structures/aho_corasick_automata/compact_aho_corasick_automata.hpp"
+#include "data_structures/aho_corasick_automata/mapped_aho_corasick_automata.hpp"
 
 typedef ads::AhoCorasickAutomata<'a', 'z'> LetterAhoCorasickAutomata;
+typedef ads::MappedAhoCorasickAutomata<'a', 'z'>
+    LetterMappedAhoCorasickAutomata;
 
 void expectSetEquality(
     const LetterAhoCorasickAutomata::occurrences& occurrences,
@@ -40,6 +49,363 @@ TEST(AhoCorasickAutomata, SimpleTest) {
   expectSetEquality(automata.findAllOccurrences(text), expected_occurrences);
 }
 
+void expectSameOccurrences(
+    const LetterAhoCorasickAutomata::occurrences& computed_occurrences,
+    const LetterAhoCorasickAutomata::occurrences& expected_occurrences) {
+  EXPECT_EQ(computed_occurrences.size(), expected_occurrences.size());
+  for (std::size_t i = 0; i < computed_occurrences.size(); ++i) {
+    EXPECT_EQ(computed_occurrences[i].str_start_pos_,
+              expected_occurrences[i].str_start_pos_);
+    EXPECT_EQ(computed_occurrences[i].str_num_,
+              expected_occurrences[i].str_num_);
+  }
+}
+
+std::string randomString(std::mt19937& gen, const std::size_t size,
+                         const char alpha_right) {
+  std::uniform_int_distribution<int> symbol_dist('a', alpha_right);
+  std::string s(size, 'a');
+  for (char& symbol : s) {
+    symbol = static_cast<char>(symbol_dist(gen));
+  }
+  return s;
+}
+
+// Occurrences of not removed strings[i] found by comparing every position
+std::vector<std::pair<std::size_t, std::size_t>> naiveOccurrences(
+    const std::vector<std::string>& strings,
+    const std::vector<bool>& is_removed, const std::string& text) {
+  std::vector<std::pair<std::size_t, std::size_t>> found;
+  for (std::size_t i = 0; i < strings.size(); ++i) {
+    for (std::size_t pos = 0;
+         !is_removed[i] && (pos + strings[i].size() <= text.size()); ++pos) {
+      if (text.compare(pos, strings[i].size(), strings[i]) == 0) {
+        found.emplace_back(pos, i);
+      }
+    }
+  }
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> sortedOccurrences(
+    const LetterAhoCorasickAutomata::occurrences& occurrences) {
+  std::vector<std::pair<std::size_t, std::size_t>> found;
+  for (const auto& occurrence : occurrences) {
+    found.emplace_back(occurrence.str_start_pos_, occurrence.str_num_);
+  }
+  std::sort(found.begin(), found.end());
+  return found;
+}
+
+TEST(AhoCorasickAutomata, ParallelSearch) {
+  std::mt19937 gen(42);
+  LetterAhoCorasickAutomata automata;
+  automata.addString("abcabcabcabc");
+  automata.addString("cab");
+  automata.addString("a");
+  for (std::size_t i = 0; i < 50; ++i) {
+    automata.addString(randomString(gen, 2 + i % 7, 'c'));
+  }
+  const std::string text = randomString(gen, 100000, 'c');
+  const auto expected_occurrences = automata.findAllOccurrences(text);
+  expectSameOccurrences(automata.findAllOccurrencesParallel(text),
+                        expected_occurrences);
+  for (std::size_t threads_count = 1; threads_count <= 8; ++threads_count) {
+    expectSameOccurrences(
+        automata.findAllOccurrencesParallel(text, threads_count),
+        expected_occurrences);
+  }
+  expectSameOccurrences(automata.findAllOccurrencesParallel("cabc", 4),
+                        automata.findAllOccurrences("cabc"));
+  EXPECT_TRUE(automata.findAllOccurrencesParallel("", 4).empty());
+}
+
+TEST(AhoCorasickAutomata, BatchSearch) {
+  std::mt19937 gen(7);
+  LetterAhoCorasickAutomata automata;
+  for (std::size_t i = 0; i < 200; ++i) {
+    automata.addString(randomString(gen, 1 + i % 5, 'd'));
+  }
+  std::vector<std::string> texts;
+  for (std::size_t i = 0; i < 37; ++i) {
+    texts.push_back(randomString(gen, (i * 13) % 120, 'd'));
+  }
+  const auto texts_occurrences = automata.findAllOccurrences(texts);
+  EXPECT_EQ(texts_occurrences.size(), texts.size());
+  for (std::size_t i = 0; i < texts.size(); ++i) {
+    expectSameOccurrences(texts_occurrences[i],
+                          automata.findAllOccurrences(texts[i]));
+  }
+  EXPECT_TRUE(automata.findAllOccurrences(std::vector<std::string>{}).empty());
+}
+
+TEST(AhoCorasickAutomata, SaveAndMapFile) {
+  std::mt19937 gen(13);
+  LetterAhoCorasickAutomata automata;
+  for (std::size_t i = 0; i < 100; ++i) {
+    automata.addString(randomString(gen, 1 + i % 6, 'e'));
+  }
+  const std::string file_path =
+      (std::filesystem::temp_directory_path() / "test_aho_corasick.bin")
+          .string();
+  automata.saveToFile(file_path);
+  const std::string text = randomString(gen, 5000, 'e');
+  {
+    ads::MappedAhoCorasickAutomata<'a', 'z'> mapped_automata(file_path);
+    expectSameOccurrences(mapped_automata.findAllOccurrences(text),
+                          automata.findAllOccurrences(text));
+    ads::MappedAhoCorasickAutomata<'a', 'z'> moved_automata(
+        std::move(mapped_automata));
+    expectSameOccurrences(moved_automata.findAllOccurrences(text),
+                          automata.findAllOccurrences(text));
+    const LetterMappedAhoCorasickAutomata trusted_automata(
+        file_path, ads::AhoCorasickFileCheck::kTrusted);
+    expectSameOccurrences(trusted_automata.findAllOccurrences(text),
+                          automata.findAllOccurrences(text));
+  }
+  EXPECT_THROW((ads::MappedAhoCorasickAutomata<'a', 'y'>(file_path)),
+               std::runtime_error);
+  {
+    std::fstream file(file_path,
+                      std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-1, std::ios::end);
+    file.put('\x7F');
+  }
+  EXPECT_THROW((ads::MappedAhoCorasickAutomata<'a', 'z'>(file_path)),
+               std::runtime_error);
+  EXPECT_NO_THROW(LetterMappedAhoCorasickAutomata(
+      file_path, ads::AhoCorasickFileCheck::kStructure));
+  std::filesystem::remove(file_path);
+  EXPECT_THROW((ads::MappedAhoCorasickAutomata<'a', 'z'>(file_path)),
+               std::runtime_error);
+}
+
+void writeFileWord(const std::string& file_path, const std::size_t word_ind,
+                   const std::uint64_t value) {
+  std::fstream file(file_path, std::ios::binary | std::ios::in | std::ios::out);
+  file.seekp(static_cast<std::streamoff>(word_ind * sizeof(std::uint64_t)));
+  file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Records are checked even without the checksum, a damaged file must not
+// let a scan read outside the mapping. A trusted file is only checked
+// against its header
+TEST(AhoCorasickAutomata, MapCorruptedFile) {
+  const std::size_t header_words =
+      sizeof(ads::AhoCorasickFileHeader) / sizeof(std::uint64_t);
+  const std::size_t node_record_words = 2 + 26;
+  LetterAhoCorasickAutomata automata;
+  automata.addString("he");
+  automata.addString("she");
+  automata.addString("hers");
+  const std::string file_path =
+      (std::filesystem::temp_directory_path() / "test_aho_corasick_bad.bin")
+          .string();
+  // Transition of the root
+  automata.saveToFile(file_path);
+  writeFileWord(file_path, header_words + 2, 1000);
+  EXPECT_THROW(LetterMappedAhoCorasickAutomata(
+                   file_path, ads::AhoCorasickFileCheck::kStructure),
+               std::runtime_error);
+  EXPECT_NO_THROW(LetterMappedAhoCorasickAutomata(
+      file_path, ads::AhoCorasickFileCheck::kTrusted));
+  // End of the output range of the root
+  automata.saveToFile(file_path);
+  writeFileWord(file_path, header_words + 1, 1000);
+  EXPECT_THROW(LetterMappedAhoCorasickAutomata(
+                   file_path, ads::AhoCorasickFileCheck::kStructure),
+               std::runtime_error);
+  // Truncated file
+  automata.saveToFile(file_path);
+  std::filesystem::resize_file(
+      file_path, std::filesystem::file_size(file_path) - sizeof(std::uint64_t));
+  EXPECT_THROW(LetterMappedAhoCorasickAutomata(
+                   file_path, ads::AhoCorasickFileCheck::kStructure),
+               std::runtime_error);
+  EXPECT_THROW(LetterMappedAhoCorasickAutomata(
+                   file_path, ads::AhoCorasickFileCheck::kTrusted),
+               std::runtime_error);
+  // nodes_count * record size wraps around to 0, so without overflow checks
+  // a file holding only the output records would match its header
+  automata.saveToFile(file_path);
+  ads::AhoCorasickFileHeader header{};
+  {
+    std::ifstream file(file_path, std::ios::binary);
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  }
+  std::filesystem::resize_file(
+      file_path, std::filesystem::file_size(file_path) -
+                     header.nodes_count * node_record_words *
+                         sizeof(std::uint64_t));
+  writeFileWord(file_path, 4, 1ULL << 62);
+  EXPECT_THROW(LetterMappedAhoCorasickAutomata(
+                   file_path, ads::AhoCorasickFileCheck::kStructure),
+               std::runtime_error);
+  std::filesystem::remove(file_path);
+}
+
+TEST(CompactAhoCorasickAutomata, SimpleTest) {
+  ads::CompactAhoCorasickAutomata<'a', 'z'> automata;
+  automata.addString("he");
+  automata.addString("she");
+  automata.addString("hers");
+  const std::string text = "ahishers";
+  std::unordered_map<std::size_t, std::unordered_set<std::size_t>>
+      expected_occurrences;
+  expected_occurrences[4].insert(0);
+  expected_occurrences[3].insert(1);
+  expected_occurrences[4].insert(2);
+  expectSetEquality(automata.findAllOccurrences(text), expected_occurrences);
+  automata.addString("his");
+  expected_occurrences[1].insert(3);
+  expectSetEquality(automata.findAllOccurrences(text), expected_occurrences);
+}
+
+TEST(CompactAhoCorasickAutomata, SameAsDense) {
+  std::mt19937 gen(21);
+  ads::CompactAhoCorasickAutomata<'a', 'z'> compact_automata;
+  std::vector<std::string> added_strings;
+  for (std::size_t round = 0; round < 3; ++round) {
+    const char alpha_right = (round % 2 == 0) ? 'z' : 'f';
+    for (std::size_t i = 0; i < 300; ++i) {
+      added_strings.push_back(randomString(gen, 1 + i % 8, alpha_right));
+      compact_automata.addString(added_strings.back());
+    }
+    LetterAhoCorasickAutomata dense_automata;
+    for (const std::string& s : added_strings) {
+      dense_automata.addString(s);
+    }
+    const std::string text = randomString(gen, 20000, alpha_right);
+    expectSameOccurrences(compact_automata.findAllOccurrences(text),
+                          dense_automata.findAllOccurrences(text));
+  }
+}
+
+TEST(AhoCorasickAutomata, RootSkipOnSparseMatches) {
+  constexpr char kByteLeft = std::numeric_limits<char>::min();
+  constexpr char kByteRight = std::numeric_limits<char>::max() - 1;
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> byte_dist(kByteLeft, kByteRight);
+  ads::AhoCorasickAutomata<kByteLeft, kByteRight> automata;
+  ads::CompactAhoCorasickAutomata<kByteLeft, kByteRight> compact_automata;
+  const std::vector<std::string> patterns = {"\x81\x82", "\xF0", "z",
+                                             "\x01\x02\x03", "zz\xFE"};
+  for (const std::string& pattern : patterns) {
+    automata.addString(pattern);
+    compact_automata.addString(pattern);
+  }
+  std::string text(100000, ' ');
+  for (char& symbol : text) {
+    symbol = static_cast<char>(byte_dist(gen));
+    if ((symbol == '\x81') || (symbol == '\xF0') || (symbol == 'z') ||
+        (symbol == '\x01')) {
+      symbol = ' ';
+    }
+  }
+  for (std::size_t i = 0; i < text.size(); i += 997) {
+    const std::string& pattern = patterns[i % patterns.size()];
+    text.replace(i, pattern.size(), pattern);
+  }
+  const auto occurrences = automata.findAllOccurrences(text);
+  EXPECT_FALSE(occurrences.empty());
+  const auto expected_occurrences = compact_automata.findAllOccurrences(text);
+  EXPECT_EQ(occurrences.size(), expected_occurrences.size());
+  for (std::size_t i = 0; i < occurrences.size(); ++i) {
+    EXPECT_EQ(occurrences[i].str_start_pos_,
+              expected_occurrences[i].str_start_pos_);
+    EXPECT_EQ(occurrences[i].str_num_, expected_occurrences[i].str_num_);
+  }
+}
+
+TEST(AhoCorasickAutomata, IncrementalUpdates) {
+  std::mt19937 gen(31);
+  LetterAhoCorasickAutomata automata;
+  std::vector<std::string> strings;
+  std::vector<bool> is_removed;
+  std::set<std::string> unique_strings;
+  const auto add_string = [&](const std::string& s) {
+    if (unique_strings.insert(s).second) {
+      strings.push_back(s);
+      is_removed.push_back(false);
+      automata.addString(s);
+    }
+  };
+  for (std::size_t i = 0; i < 200; ++i) {
+    add_string(randomString(gen, 1 + i % 6, 'd'));
+  }
+  const std::string text = randomString(gen, 1000, 'd');
+  for (std::size_t round = 0; round < 20; ++round) {
+    for (std::size_t i = 0; i < 30; ++i) {
+      add_string(randomString(gen, 1 + (round + i) % 9, 'd'));
+    }
+    for (std::size_t i = 0; i < 5; ++i) {
+      const std::size_t removed_ind = gen() % strings.size();
+      EXPECT_EQ(automata.removeString(strings[removed_ind]),
+                !is_removed[removed_ind]);
+      is_removed[removed_ind] = true;
+    }
+    if (round % 5 == 4) {
+      automata.mergeDelta();
+    }
+    const auto expected_occurrences =
+        naiveOccurrences(strings, is_removed, text);
+    EXPECT_EQ(sortedOccurrences(automata.findAllOccurrences(text)),
+              expected_occurrences);
+    EXPECT_EQ(sortedOccurrences(automata.findAllOccurrencesParallel(text, 2)),
+              expected_occurrences);
+  }
+  EXPECT_FALSE(automata.removeString("dddddddddddddddddddd"));
+}
+
+TEST(AhoCorasickAutomata, DuplicateStrings) {
+  std::mt19937 gen(32);
+  LetterAhoCorasickAutomata automata;
+  ads::CompactAhoCorasickAutomata<'a', 'z'> compact_automata;
+  std::vector<std::string> strings;
+  std::vector<bool> is_removed;
+  for (std::size_t i = 0; i < 300; ++i) {
+    strings.push_back(randomString(gen, 1 + i % 3, 'c'));
+    is_removed.push_back(false);
+    automata.addString(strings.back());
+    compact_automata.addString(strings.back());
+  }
+  const std::string text = randomString(gen, 2000, 'c');
+  auto expected_occurrences = naiveOccurrences(strings, is_removed, text);
+  EXPECT_EQ(sortedOccurrences(automata.findAllOccurrences(text)),
+            expected_occurrences);
+  EXPECT_EQ(sortedOccurrences(compact_automata.findAllOccurrences(text)),
+            expected_occurrences);
+  for (std::size_t i = 0; i < 10; ++i) {
+    const std::string removed_string = strings[gen() % strings.size()];
+    bool is_present = false;
+    for (std::size_t j = 0; j < strings.size(); ++j) {
+      if (strings[j] == removed_string) {
+        is_present = is_present || !is_removed[j];
+        is_removed[j] = true;
+      }
+    }
+    EXPECT_EQ(automata.removeString(removed_string), is_present);
+    automata.addString(strings[i]);
+    strings.push_back(strings[i]);
+    is_removed.push_back(false);
+    expected_occurrences = naiveOccurrences(strings, is_removed, text);
+    EXPECT_EQ(sortedOccurrences(automata.findAllOccurrences(text)),
+              expected_occurrences);
+  }
+  const std::filesystem::path file_path =
+      std::filesystem::temp_directory_path() /
+      "customads_aho_corasick_duplicates.bin";
+  automata.saveToFile(file_path.string());
+  {
+    const ads::MappedAhoCorasickAutomata<'a', 'z'> mapped_automata(
+        file_path.string());
+    EXPECT_EQ(sortedOccurrences(mapped_automata.findAllOccurrences(text)),
+              expected_occurrences);
+  }
+  std::filesystem::remove(file_path);
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,139 @@
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/concurrent_segment_tree/concurrent_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+
+using SumConcurrentSegmentTree =
+    ads::ConcurrentSegmentTree<std::int64_t, ads::Sum<std::int64_t>, 0>;
+
+TEST(ConcurrentSegmentTree, UpdateTree) {
+  std::vector<std::int64_t> vec = {1, 2, 3, 7, 10};
+  SumConcurrentSegmentTree segment_tree(vec);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 4ULL), 23);
+  EXPECT_EQ(segment_tree.segmentQuery(1ULL, 3ULL), 12);
+  segment_tree.indexUpdate(2ULL, -3);
+  EXPECT_EQ(segment_tree.segmentQuery(1ULL, 3ULL), 6);
+  std::vector<std::pair<std::size_t, std::int64_t>> updates = {
+      {0, 5}, {4, 0}, {0, 6}};
+  segment_tree.applyUpdates(updates);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 4ULL), 12);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 0ULL), 6);
+}
+
+TEST(ConcurrentSegmentTree, ThrowError) {
+  std::vector<std::int64_t> empty_vec;
+  EXPECT_THROW((SumConcurrentSegmentTree(empty_vec)), std::runtime_error);
+  std::vector<std::int64_t> vec = {1, 2, 3, 7, 10};
+  SumConcurrentSegmentTree segment_tree(vec);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(3ULL, 2ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(2ULL, 5ULL)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(5ULL, 1), std::range_error);
+  std::vector<std::pair<std::size_t, std::int64_t>> updates = {{0, 5},
+                                                               {5, 1}};
+  EXPECT_THROW(segment_tree.applyUpdates(updates), std::range_error);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 0ULL), 1);
+}
+
+// The writer moves amounts between elements in atomic batches, so readers
+// must always see the same total
+TEST(ConcurrentSegmentTree, ReadersSeeConservedSum) {
+  const std::size_t vec_size = 1000;
+  const std::int64_t initial_value = 100;
+  std::vector<std::int64_t> vec(vec_size, initial_value);
+  SumConcurrentSegmentTree segment_tree(vec);
+  const std::int64_t total =
+      initial_value * static_cast<std::int64_t>(vec_size);
+  std::atomic<bool> is_writing = true;
+  std::atomic<std::size_t> wrong_results = 0;
+  std::atomic<std::size_t> reads_count = 0;
+  std::vector<std::thread> readers;
+  for (std::size_t reader_ind = 0; reader_ind < 3; ++reader_ind) {
+    readers.emplace_back([&] {
+      std::int64_t last_counter = 0;
+      while (is_writing.load()) {
+        if (segment_tree.segmentQuery(0ULL, vec_size - 1) != total) {
+          ++wrong_results;
+        }
+        // The last element only grows
+        const std::int64_t counter =
+            segment_tree.segmentQuery(vec_size - 1, vec_size - 1);
+        if (counter < last_counter) {
+          ++wrong_results;
+        }
+        last_counter = counter;
+        ++reads_count;
+      }
+    });
+  }
+  std::mt19937 gen(44);
+  // Keeps writing until the readers had a chance to overlap the writes
+  for (std::size_t step = 0;
+       (step < 20000) || (reads_count.load() < 2'000'000); ++step) {
+    const std::size_t from = gen() % (vec_size - 1);
+    const std::size_t to = gen() % vec_size;
+    if (from == to) {
+      continue;
+    }
+    vec[from] -= 1;
+    vec[to] += 1;
+    std::vector<std::pair<std::size_t, std::int64_t>> updates = {
+        {from, vec[from]}, {to, vec[to]}};
+    segment_tree.applyUpdates(updates);
+  }
+  is_writing.store(false);
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(wrong_results.load(), 0ULL);
+  for (std::size_t vec_ind = 0; vec_ind < vec_size; ++vec_ind) {
+    EXPECT_EQ(segment_tree.segmentQuery(vec_ind, vec_ind), vec[vec_ind]);
+  }
+}
+
+// The writer never pauses, readers must still finish their queries
+TEST(ConcurrentSegmentTree, ReadersProgressUnderContinuousWrites) {
+  const std::size_t vec_size = 1000;
+  const std::size_t queries_count = 100'000;
+  std::vector<std::int64_t> vec(vec_size, 1);
+  SumConcurrentSegmentTree segment_tree(vec);
+  std::atomic<std::size_t> running_readers = 3;
+  std::atomic<std::size_t> wrong_results = 0;
+  std::vector<std::thread> readers;
+  for (std::size_t reader_ind = 0; reader_ind < 3; ++reader_ind) {
+    readers.emplace_back([&] {
+      for (std::size_t query_ind = 0; query_ind < queries_count;
+           ++query_ind) {
+        if (segment_tree.segmentQuery(0ULL, vec_size - 1) !=
+            static_cast<std::int64_t>(vec_size)) {
+          ++wrong_results;
+        }
+      }
+      --running_readers;
+    });
+  }
+  std::size_t writes_count = 0;
+  for (std::size_t vec_ind = 0; running_readers.load() > 0;
+       vec_ind = (vec_ind + 1) % vec_size) {
+    segment_tree.indexUpdate(vec_ind, 1);
+    ++writes_count;
+  }
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(wrong_results.load(), 0ULL);
+  EXPECT_GT(writes_count, 0ULL);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
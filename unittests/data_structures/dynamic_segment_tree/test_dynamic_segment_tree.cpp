@@ -0,0 +1,81 @@
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/dynamic_segment_tree/dynamic_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+
+using SumDynamicSegmentTree =
+    ads::DynamicSegmentTree<std::int64_t, ads::Sum<std::int64_t>, 0>;
+
+TEST(DynamicSegmentTree, FullIndexRange) {
+  constexpr std::uint64_t kMax = std::numeric_limits<std::uint64_t>::max();
+  SumDynamicSegmentTree segment_tree;
+  EXPECT_EQ(segment_tree.maxIndex(), kMax);
+  EXPECT_EQ(segment_tree.segmentQuery(0, kMax), 0);
+  segment_tree.indexUpdate(0, 5);
+  segment_tree.indexUpdate(kMax, 7);
+  segment_tree.indexUpdate(1'700'000'000'000ULL, -3);
+  EXPECT_EQ(segment_tree.segmentQuery(0, kMax), 9);
+  EXPECT_EQ(segment_tree.segmentQuery(1, kMax), 4);
+  EXPECT_EQ(segment_tree.segmentQuery(0, kMax - 1), 2);
+  EXPECT_EQ(segment_tree.segmentQuery(kMax, kMax), 7);
+  EXPECT_EQ(segment_tree.segmentQuery(1'700'000'000'000ULL,
+                                      1'700'000'000'000ULL),
+            -3);
+  EXPECT_LE(segment_tree.nodesCount(), 2ULL + 3ULL * 64ULL);
+  segment_tree.indexUpdate(kMax, 1);
+  EXPECT_EQ(segment_tree.segmentQuery(0, kMax), 3);
+  segment_tree.clear();
+  EXPECT_EQ(segment_tree.segmentQuery(0, kMax), 0);
+  EXPECT_EQ(segment_tree.nodesCount(), 2ULL);
+}
+
+TEST(DynamicSegmentTree, ThrowError) {
+  SumDynamicSegmentTree segment_tree(99);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(8, 3)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(2, 100)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(100, 1), std::range_error);
+}
+
+TEST(DynamicSegmentTree, SameAsMap) {
+  std::mt19937_64 gen(40);
+  std::uniform_int_distribution<std::int64_t> value_dist(-1000, 1000);
+  const std::uint64_t max_index = 1'000'000'000'000ULL;
+  std::uniform_int_distribution<std::uint64_t> index_dist(0, max_index);
+  SumDynamicSegmentTree segment_tree(max_index);
+  std::map<std::uint64_t, std::int64_t> values;
+  for (std::size_t step = 0; step < 2000; ++step) {
+    if (step % 2 == 0) {
+      // Reuse an updated index from time to time
+      const std::uint64_t ind = (values.empty() || (step % 6 != 0))
+                                    ? index_dist(gen)
+                                    : values.begin()->first;
+      const std::int64_t value = value_dist(gen);
+      segment_tree.indexUpdate(ind, value);
+      values[ind] = value;
+      continue;
+    }
+    std::uint64_t left = index_dist(gen);
+    std::uint64_t right = index_dist(gen);
+    if (left > right) {
+      std::swap(left, right);
+    }
+    std::int64_t expected = 0;
+    for (auto it = values.lower_bound(left);
+         (it != values.end()) && (it->first <= right); ++it) {
+      expected += it->second;
+    }
+    EXPECT_EQ(segment_tree.segmentQuery(left, right), expected);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <functional>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/fenwick_tree/fenwick_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+
+template <typename T>
+struct Difference {
+  T operator()(const T& left, const T& right) const noexcept {
+    return left - right;
+  }
+};
+
+template <typename T>
+struct Xor {
+  T operator()(const T& left, const T& right) const noexcept {
+    return left ^ right;
+  }
+};
+
+using SumFenwickTree =
+    ads::FenwickTree<int, ads::Sum<int>, 0, Difference<int>>;
+
+TEST(FenwickTree, CreateTree) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  SumFenwickTree fenwick_tree(vec);
+  EXPECT_EQ(3, fenwick_tree.segmentQuery(0ULL, 1ULL));
+  EXPECT_EQ(20, fenwick_tree.segmentQuery(2ULL, 4ULL));
+  EXPECT_EQ(13, fenwick_tree.prefixQuery(3ULL));
+}
+
+TEST(FenwickTree, UpdateTree) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  SumFenwickTree fenwick_tree(vec);
+  fenwick_tree.indexUpdate(0, 10);
+  fenwick_tree.indexUpdate(1, 7);
+  EXPECT_EQ(20, fenwick_tree.segmentQuery(0ULL, 2ULL));
+  EXPECT_EQ(20, fenwick_tree.segmentQuery(2ULL, 4ULL));
+  fenwick_tree.indexApply(4, -4);
+  EXPECT_EQ(6, fenwick_tree.segmentQuery(4ULL, 4ULL));
+}
+
+TEST(FenwickTree, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW((SumFenwickTree(empty_vec)), std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  SumFenwickTree fenwick_tree(vec);
+  EXPECT_THROW(static_cast<void>(fenwick_tree.segmentQuery(8ULL, 3ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(fenwick_tree.segmentQuery(2ULL, 7ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(fenwick_tree.prefixQuery(5ULL)),
+               std::range_error);
+  EXPECT_THROW(fenwick_tree.indexUpdate(5ULL, 8), std::range_error);
+  EXPECT_THROW(fenwick_tree.indexApply(5ULL, 8), std::range_error);
+}
+
+TEST(FenwickTree, LowerBound) {
+  std::vector<int> vec = {1, 0, 3, 2, 0, 0, 4};
+  SumFenwickTree fenwick_tree(vec);
+  EXPECT_EQ(fenwick_tree.lowerBound(0), 0ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(1), 0ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(2), 2ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(4), 2ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(5), 3ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(7), 6ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(10), 6ULL);
+  EXPECT_EQ(fenwick_tree.lowerBound(11), vec.size());
+}
+
+TEST(FenwickTree, SameAsSegmentTree) {
+  std::mt19937 gen(36);
+  std::uniform_int_distribution<std::uint32_t> value_dist;
+  for (std::size_t vec_size = 1; vec_size <= 70; ++vec_size) {
+    std::vector<std::uint32_t> vec(vec_size);
+    for (std::uint32_t& value : vec) {
+      value = value_dist(gen);
+    }
+    ads::FenwickTree<std::uint32_t, std::bit_xor<std::uint32_t>, 0U,
+                     Xor<std::uint32_t>>
+        fenwick_tree(vec);
+    ads::SegmentTree<std::uint32_t, std::bit_xor<std::uint32_t>, 0U>
+        segment_tree(vec);
+    for (std::size_t step = 0; step < 100; ++step) {
+      const std::size_t vec_ind = gen() % vec_size;
+      const std::uint32_t value = value_dist(gen);
+      fenwick_tree.indexUpdate(vec_ind, value);
+      segment_tree.indexUpdate(vec_ind, value);
+      std::size_t left = gen() % vec_size;
+      std::size_t right = gen() % vec_size;
+      if (left > right) {
+        std::swap(left, right);
+      }
+      EXPECT_EQ(fenwick_tree.segmentQuery(left, right),
+                segment_tree.segmentQuery(left, right));
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <queue>
+#include <random>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "heap_helpers.hpp"
+#include "data_structures/heap/compare/compare.hpp"
+#include "data_structures/heap/heap/heap.hpp"
+
+template <std::size_t kArity>
+void expectSameAsPriorityQueue(const std::uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  ads::Heap<int, ads::MoreCompare<int>, kArity> heap;
+  std::priority_queue<int> expected_heap;
+  for (std::size_t step = 0; step < 5000; ++step) {
+    if ((gen() % 3 == 0) && !expected_heap.empty()) {
+      EXPECT_EQ(heap.top(), expected_heap.top());
+      heap.pop();
+      expected_heap.pop();
+    } else {
+      const int value = value_dist(gen);
+      heap.push(value);
+      expected_heap.push(value);
+    }
+    EXPECT_EQ(heap.getSize(), expected_heap.size());
+  }
+  while (!expected_heap.empty()) {
+    EXPECT_EQ(heap.top(), expected_heap.top());
+    heap.pop();
+    expected_heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(Heap, SameAsPriorityQueue) {
+  expectSameAsPriorityQueue<2>(46);
+  expectSameAsPriorityQueue<3>(47);
+  expectSameAsPriorityQueue<4>(48);
+  expectSameAsPriorityQueue<8>(49);
+}
+
+TEST(Heap, ThrowError) {
+  ads::Heap<int, ads::MoreCompare<int>> heap;
+  EXPECT_THROW(static_cast<void>(heap.top()), std::length_error);
+  EXPECT_THROW(heap.pop(), std::length_error);
+  heap.push(1);
+  heap.pop();
+  EXPECT_THROW(heap.pop(), std::length_error);
+}
+
+TEST(Heap, EmplaceStrings) {
+  ads::Heap<std::string, ads::MoreCompare<std::string>, 4> heap;
+  heap.emplace(40ULL, 'b');
+  heap.emplace("a long string that does not fit into the small buffer");
+  heap.push(std::string(30, 'c'));
+  const std::string value = "bb";
+  heap.push(value);
+  EXPECT_EQ(value, "bb");
+  EXPECT_EQ(heap.top(), std::string(30, 'c'));
+  heap.pop();
+  EXPECT_EQ(heap.top(), std::string(40, 'b'));
+  heap.pop();
+  EXPECT_EQ(heap.top(), "bb");
+  heap.pop();
+  EXPECT_EQ(heap.top(),
+            "a long string that does not fit into the small buffer");
+  heap.pop();
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(Heap, PushElementOfHeap) {
+  ads::Heap<std::string, ads::MoreCompare<std::string>> heap(1);
+  heap.push(std::string(40, 'a'));
+  // Reallocation must not invalidate the pushed element
+  heap.push(heap.top());
+  heap.push(heap.top());
+  EXPECT_EQ(heap.getSize(), 3ULL);
+  for (std::size_t ind = 0; ind < 3; ++ind) {
+    EXPECT_EQ(heap.top(), std::string(40, 'a'));
+    heap.pop();
+  }
+}
+
+TEST(Heap, MoveOnlyValues) {
+  ads::Heap<std::unique_ptr<int>, ads::PointeeMoreCompare> heap;
+  for (int value : {5, 1, 8, 3, 9, 2}) {
+    auto pointer = std::make_unique<int>(value);
+    heap.push(std::move(pointer));
+    EXPECT_EQ(pointer, nullptr);
+  }
+  heap.emplace(new int(7));
+  std::vector<int> values;
+  while (!heap.empty()) {
+    values.push_back(*heap.top());
+    heap.pop();
+  }
+  EXPECT_EQ(values, std::vector<int>({9, 8, 7, 5, 3, 2, 1}));
+}
+
+TEST(Heap, CopyAndMove) {
+  ads::Heap<std::string, ads::MoreCompare<std::string>> heap;
+  for (const char letter : {'d', 'a', 'c', 'b'}) {
+    heap.push(std::string(20, letter));
+  }
+  ads::Heap<std::string, ads::MoreCompare<std::string>> copied_heap(heap);
+  heap.pop();
+  EXPECT_EQ(copied_heap.getSize(), 4ULL);
+  EXPECT_EQ(copied_heap.top(), std::string(20, 'd'));
+  ads::Heap<std::string, ads::MoreCompare<std::string>> moved_heap(
+      std::move(copied_heap));
+  EXPECT_EQ(moved_heap.getSize(), 4ULL);
+  copied_heap = heap;
+  EXPECT_EQ(copied_heap.top(), std::string(20, 'c'));
+  moved_heap = std::move(copied_heap);
+  EXPECT_EQ(moved_heap.getSize(), 3ULL);
+  EXPECT_EQ(moved_heap.top(), std::string(20, 'c'));
+}
+
+TEST(Heap, BulkConstruction) {
+  std::vector<int> vec = {3, 9, 1, 7, 5, 8, 2, 6, 4, 0};
+  std::vector<int> expected = vec;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  ads::Heap<int, ads::MoreCompare<int>> pointer_heap(vec.data(), vec.size());
+  EXPECT_EQ(ads::popAll(pointer_heap), expected);
+  ads::Heap<int, ads::MoreCompare<int>, 3> vector_heap(vec);
+  EXPECT_EQ(vec.size(), 10ULL);
+  EXPECT_EQ(ads::popAll(vector_heap), expected);
+  std::list<int> list(vec.begin(), vec.end());
+  ads::Heap<int, ads::MoreCompare<int>> list_heap(list);
+  EXPECT_EQ(ads::popAll(list_heap), expected);
+  ads::Heap<int, ads::MoreCompare<int>> view_heap(std::views::iota(0, 10));
+  EXPECT_EQ(ads::popAll(view_heap), std::vector<int>({9, 8, 7, 6, 5, 4, 3, 2, 1,
+                                                 0}));
+  ads::Heap<int, ads::MoreCompare<int>> single_heap(vec.data(), 1);
+  EXPECT_EQ(single_heap.top(), 3);
+  std::vector<std::unique_ptr<int>> pointers;
+  for (const int value : vec) {
+    pointers.push_back(std::make_unique<int>(value));
+  }
+  ads::Heap<std::unique_ptr<int>, ads::PointeeMoreCompare> moved_heap(
+      std::move(pointers));
+  EXPECT_EQ(moved_heap.getSize(), 10ULL);
+  EXPECT_EQ(*moved_heap.top(), 9);
+}
+
+TEST(Heap, PushRangeSameAsPriorityQueue) {
+  std::mt19937 gen(47);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  ads::Heap<int, ads::MoreCompare<int>, 4> heap;
+  std::priority_queue<int> expected_heap;
+  for (const std::size_t batch_size : {0ULL, 5ULL, 1ULL, 100ULL, 3ULL, 2000ULL,
+                                       10ULL, 5000ULL}) {
+    std::vector<int> batch(batch_size);
+    for (int& value : batch) {
+      value = value_dist(gen);
+      expected_heap.push(value);
+    }
+    heap.pushRange(batch);
+    EXPECT_EQ(heap.getSize(), expected_heap.size());
+    for (std::size_t step = 0; step < batch_size / 2; ++step) {
+      EXPECT_EQ(heap.top(), expected_heap.top());
+      heap.pop();
+      expected_heap.pop();
+    }
+  }
+  std::vector<int> expected;
+  while (!expected_heap.empty()) {
+    expected.push_back(expected_heap.top());
+    expected_heap.pop();
+  }
+  EXPECT_EQ(ads::popAll(heap), expected);
+}
+
+// A temporary view does not own its elements, so they must be copied
+TEST(Heap, PushRangeOfViews) {
+  std::vector<std::string> source;
+  for (const char letter : {'c', 'a', 'e', 'b', 'd'}) {
+    source.emplace_back(20, letter);
+  }
+  const std::vector<std::string> expected_source = source;
+  ads::Heap<std::string, ads::MoreCompare<std::string>> heap;
+  heap.pushRange(source | std::views::filter([](const std::string& value) {
+                   return value[0] != 'b';
+                 }));
+  EXPECT_EQ(source, expected_source);
+  heap.pushRange(source |
+                 std::views::transform([](std::string& value) -> std::string& {
+                   return value;
+                 }));
+  EXPECT_EQ(source, expected_source);
+  ads::Heap<std::string, ads::MoreCompare<std::string>> view_heap(
+      std::views::filter(source, [](const std::string& value) {
+        return value[0] > 'b';
+      }));
+  EXPECT_EQ(source, expected_source);
+  EXPECT_EQ(ads::popAll(view_heap),
+            std::vector<std::string>({std::string(20, 'e'),
+                                      std::string(20, 'd'),
+                                      std::string(20, 'c')}));
+  std::vector<std::string> expected;
+  for (const char letter : {'e', 'e', 'd', 'd', 'c', 'c', 'b', 'a', 'a'}) {
+    expected.emplace_back(20, letter);
+  }
+  EXPECT_EQ(ads::popAll(heap), expected);
+}
+
+TEST(Heap, PopN) {
+  ads::Heap<std::string, ads::MoreCompare<std::string>> heap(
+      std::vector<std::string>({"b", "e", "a", "d", "c"}));
+  std::vector<std::string> values(3);
+  EXPECT_EQ(heap.popN(3, values.begin()), values.end());
+  EXPECT_EQ(values, std::vector<std::string>({"e", "d", "c"}));
+  EXPECT_EQ(heap.getSize(), 2ULL);
+  EXPECT_THROW(heap.popN(3, values.begin()), std::length_error);
+  EXPECT_EQ(heap.top(), "b");
+  heap.popN(0, values.begin());
+  EXPECT_EQ(heap.getSize(), 2ULL);
+}
+
+TEST(Heap, Merge) {
+  std::mt19937 gen(48);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  for (const std::size_t first_size : {0ULL, 3ULL, 1000ULL}) {
+    for (const std::size_t second_size : {0ULL, 1ULL, 20ULL, 3000ULL}) {
+      ads::Heap<int, ads::MoreCompare<int>> first_heap;
+      ads::Heap<int, ads::MoreCompare<int>> second_heap;
+      std::vector<int> expected;
+      for (std::size_t ind = 0; ind < first_size + second_size; ++ind) {
+        const int value = value_dist(gen);
+        expected.push_back(value);
+        if (ind < first_size) {
+          first_heap.push(value);
+        } else {
+          second_heap.push(value);
+        }
+      }
+      std::sort(expected.begin(), expected.end(), std::greater<>());
+      first_heap.merge(std::move(second_heap));
+      EXPECT_TRUE(second_heap.empty());
+      EXPECT_EQ(ads::popAll(first_heap), expected);
+      second_heap.push(1);
+      EXPECT_EQ(second_heap.top(), 1);
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "affine.hpp"
+#include "data_structures/iterative_segment_tree/iterative_segment_tree.hpp"
+
+template <typename T>
+struct Sum {
+  T operator()(const T& left, const T& right) const noexcept {
+    return left + right;
+  }
+};
+
+template <typename T>
+struct Max {
+  T operator()(const T& left, const T& right) const noexcept {
+    return std::max(left, right);
+  }
+};
+
+TEST(IterativeSegmentTree, CreateTree) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::IterativeSegmentTree<int, Sum<int>, 0> segment_tree(vec);
+  EXPECT_EQ(3, segment_tree.segmentQuery(0ULL, 1ULL));
+  EXPECT_EQ(20, segment_tree.segmentQuery(2ULL, 4ULL));
+  EXPECT_EQ(23, segment_tree.segmentQuery(0ULL, 4ULL));
+}
+
+TEST(IterativeSegmentTree, UpdateTree) {
+  std::vector<int> vec = {-4, -10, 15, 25, 6, 2, 3, 7, 10, 0, -45};
+  ads::IterativeSegmentTree<int, Max<int>, std::numeric_limits<int>::min()>
+      segment_tree(vec);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 10ULL), 25);
+  EXPECT_EQ(segment_tree.segmentQuery(8ULL, 10ULL), 10);
+  segment_tree.indexUpdate(0ULL, 30);
+  segment_tree.indexUpdate(8ULL, 6);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 6ULL), 30);
+  EXPECT_EQ(segment_tree.segmentQuery(7ULL, 10ULL), 7);
+}
+
+TEST(IterativeSegmentTree, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW((ads::IterativeSegmentTree<int, Sum<int>, 0>(empty_vec)),
+               std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::IterativeSegmentTree<int, Sum<int>, 0> segment_tree(vec);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(8ULL, 3ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(2ULL, 7ULL)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(5ULL, 8), std::range_error);
+}
+
+TEST(IterativeSegmentTree, NonCommutativeOperator) {
+  std::mt19937 gen(34);
+  std::uniform_int_distribution<std::int64_t> value_dist(0, 1000);
+  for (std::size_t vec_size = 1; vec_size <= 40; ++vec_size) {
+    std::vector<ads::Affine> vec(vec_size);
+    for (ads::Affine& value : vec) {
+      value = ads::Affine{.mul_ = value_dist(gen), .add_ = value_dist(gen)};
+    }
+    ads::IterativeSegmentTree<ads::Affine, ads::Compose,
+                              ads::Affine{.mul_ = 1, .add_ = 0}>
+        segment_tree(vec);
+    for (std::size_t step = 0; step < 200; ++step) {
+      const std::size_t vec_ind = gen() % vec_size;
+      vec[vec_ind] =
+          ads::Affine{.mul_ = value_dist(gen), .add_ = value_dist(gen)};
+      segment_tree.indexUpdate(vec_ind, vec[vec_ind]);
+      std::size_t left = gen() % vec_size;
+      std::size_t right = gen() % vec_size;
+      if (left > right) {
+        std::swap(left, right);
+      }
+      ads::Affine expected{.mul_ = 1, .add_ = 0};
+      for (std::size_t i = left; i <= right; ++i) {
+        expected = ads::Compose()(expected, vec[i]);
+      }
+      EXPECT_EQ(segment_tree.segmentQuery(left, right), expected);
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "affine.hpp"
+#include "data_structures/lazy_segment_tree/lazy_segment_tree.hpp"
+
+template <typename T>
+struct Sum {
+  T operator()(const T& left, const T& right) const noexcept {
+    return left + right;
+  }
+};
+
+template <typename T>
+struct Min {
+  T operator()(const T& left, const T& right) const noexcept {
+    return std::min(left, right);
+  }
+};
+
+template <typename T>
+struct AddToSum {
+  T operator()(const T& value, const T& tag,
+               const std::size_t size) const noexcept {
+    return value + tag * static_cast<T>(size);
+  }
+
+  T compose(const T& first, const T& second) const noexcept {
+    return first + second;
+  }
+
+  T repeat(const T& value, const std::size_t size) const noexcept {
+    return value * static_cast<T>(size);
+  }
+};
+
+template <typename T>
+struct AddToMin {
+  T operator()(const T& value, const T& tag,
+               const std::size_t /*size*/) const noexcept {
+    return value + tag;
+  }
+
+  T compose(const T& first, const T& second) const noexcept {
+    return first + second;
+  }
+
+  T repeat(const T& value, const std::size_t /*size*/) const noexcept {
+    return value;
+  }
+};
+
+struct ModSum {
+  std::int64_t operator()(const std::int64_t& left,
+                          const std::int64_t& right) const noexcept {
+    return (left + right) % ads::Affine::kModulo;
+  }
+};
+
+struct AffineToSum {
+  std::int64_t operator()(const std::int64_t& value, const ads::Affine& tag,
+                          const std::size_t size) const noexcept {
+    return (value * tag.mul_ + tag.add_ * static_cast<std::int64_t>(size) %
+                                   ads::Affine::kModulo) %
+           ads::Affine::kModulo;
+  }
+
+  ads::Affine compose(const ads::Affine& first,
+                      const ads::Affine& second) const noexcept {
+    return ads::Compose()(first, second);
+  }
+
+  std::int64_t repeat(const std::int64_t& value,
+                      const std::size_t size) const noexcept {
+    return value * static_cast<std::int64_t>(size) % ads::Affine::kModulo;
+  }
+};
+
+TEST(LazySegmentTree, RangeAdd) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::LazySegmentTree<int, Sum<int>, 0, int, AddToSum<int>> segment_tree(vec);
+  segment_tree.rangeApply(1ULL, 3ULL, 5);
+  EXPECT_EQ(38, segment_tree.segmentQuery(0ULL, 4ULL));
+  EXPECT_EQ(20, segment_tree.segmentQuery(2ULL, 3ULL));
+  segment_tree.rangeApply(0ULL, 1ULL, -1);
+  EXPECT_EQ(6, segment_tree.segmentQuery(0ULL, 1ULL));
+  EXPECT_EQ(6, segment_tree.segmentQuery(1ULL, 1ULL));
+}
+
+TEST(LazySegmentTree, RangeAssign) {
+  std::vector<int> vec = {-4, -10, 15, 25, 6, 2, 3, 7, 10, 0, -45};
+  ads::LazySegmentTree<int, Min<int>, std::numeric_limits<int>::max(), int,
+                       AddToMin<int>>
+      segment_tree(vec);
+  segment_tree.rangeAssign(0ULL, 9ULL, 20);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 9ULL), 20);
+  EXPECT_EQ(segment_tree.segmentQuery(5ULL, 10ULL), -45);
+  segment_tree.rangeApply(3ULL, 4ULL, -30);
+  EXPECT_EQ(segment_tree.segmentQuery(0ULL, 3ULL), -10);
+  EXPECT_EQ(segment_tree.segmentQuery(4ULL, 4ULL), -10);
+  EXPECT_EQ(segment_tree.segmentQuery(5ULL, 9ULL), 20);
+  segment_tree.indexUpdate(7ULL, 1);
+  EXPECT_EQ(segment_tree.segmentQuery(5ULL, 9ULL), 1);
+}
+
+TEST(LazySegmentTree, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW(
+      (ads::LazySegmentTree<int, Sum<int>, 0, int, AddToSum<int>>(empty_vec)),
+      std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::LazySegmentTree<int, Sum<int>, 0, int, AddToSum<int>> segment_tree(vec);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(3ULL, 2ULL)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.rangeAssign(2ULL, 5ULL, 1), std::range_error);
+  EXPECT_THROW(segment_tree.rangeApply(4ULL, 1ULL, 1), std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(5ULL, 8), std::range_error);
+}
+
+TEST(LazySegmentTree, SameAsNaiveAffine) {
+  std::mt19937 gen(33);
+  for (const std::size_t vec_size : {1ULL, 2ULL, 7ULL, 64ULL, 100ULL}) {
+    std::uniform_int_distribution<std::size_t> index_dist(0, vec_size - 1);
+    std::uniform_int_distribution<std::int64_t> value_dist(0, 1000);
+    std::vector<std::int64_t> vec(vec_size);
+    for (std::int64_t& value : vec) {
+      value = value_dist(gen);
+    }
+    ads::LazySegmentTree<std::int64_t, ModSum, 0, ads::Affine, AffineToSum>
+        segment_tree(vec);
+    for (std::size_t step = 0; step < 2000; ++step) {
+      std::size_t left = index_dist(gen);
+      std::size_t right = index_dist(gen);
+      if (left > right) {
+        std::swap(left, right);
+      }
+      switch (gen() % 3) {
+        case 0: {
+          const std::int64_t value = value_dist(gen);
+          segment_tree.rangeAssign(left, right, value);
+          std::fill(vec.begin() + static_cast<std::ptrdiff_t>(left),
+                    vec.begin() + static_cast<std::ptrdiff_t>(right) + 1,
+                    value);
+          break;
+        }
+        case 1: {
+          const ads::Affine tag{.mul_ = value_dist(gen),
+                                .add_ = value_dist(gen)};
+          segment_tree.rangeApply(left, right, tag);
+          for (std::size_t i = left; i <= right; ++i) {
+            vec[i] = (vec[i] * tag.mul_ + tag.add_) % ads::Affine::kModulo;
+          }
+          break;
+        }
+        default: {
+          std::int64_t expected = 0;
+          for (std::size_t i = left; i <= right; ++i) {
+            expected = (expected + vec[i]) % ads::Affine::kModulo;
+          }
+          EXPECT_EQ(segment_tree.segmentQuery(left, right), expected);
+        }
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
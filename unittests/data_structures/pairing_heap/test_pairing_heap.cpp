@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "heap_helpers.hpp"
+#include "data_structures/heap/compare/compare.hpp"
+#include "data_structures/pairing_heap/pairing_heap.hpp"
+
+using IntPairingHeap = ads::PairingHeap<int, ads::MoreCompare<int>>;
+
+TEST(PairingHeap, SameAsPriorityQueue) {
+  std::mt19937 gen(50);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  IntPairingHeap heap;
+  std::priority_queue<int> expected_heap;
+  for (std::size_t step = 0; step < 20000; ++step) {
+    if ((gen() % 3 == 0) && !expected_heap.empty()) {
+      EXPECT_EQ(heap.top(), expected_heap.top());
+      heap.pop();
+      expected_heap.pop();
+    } else {
+      const int value = value_dist(gen);
+      heap.push(value);
+      expected_heap.push(value);
+    }
+    EXPECT_EQ(heap.getSize(), expected_heap.size());
+  }
+  while (!expected_heap.empty()) {
+    EXPECT_EQ(heap.top(), expected_heap.top());
+    heap.pop();
+    expected_heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(PairingHeap, ThrowError) {
+  IntPairingHeap heap;
+  EXPECT_THROW(static_cast<void>(heap.top()), std::length_error);
+  EXPECT_THROW(heap.pop(), std::length_error);
+  heap.push(1);
+  heap.pop();
+  EXPECT_THROW(heap.pop(), std::length_error);
+  EXPECT_THROW(IntPairingHeap(std::shared_ptr<IntPairingHeap::Pool>()),
+               std::invalid_argument);
+}
+
+// Shards share one pool and are merged into each other in O(1)
+TEST(PairingHeap, MergeShards) {
+  std::mt19937 gen(51);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  auto pool = std::make_shared<IntPairingHeap::Pool>();
+  std::vector<IntPairingHeap> shards;
+  std::vector<std::priority_queue<int>> expected_shards(16);
+  for (std::size_t shard = 0; shard < expected_shards.size(); ++shard) {
+    shards.emplace_back(pool);
+  }
+  std::size_t elements_count = 0;
+  std::size_t max_elements_count = 0;
+  for (std::size_t step = 0; step < 20000; ++step) {
+    const std::size_t shard = gen() % shards.size();
+    const std::size_t operation = gen() % 8;
+    if (operation == 0) {
+      const std::size_t other_shard = gen() % shards.size();
+      shards[shard].merge(std::move(shards[other_shard]));
+      if (shard != other_shard) {
+        EXPECT_TRUE(shards[other_shard].empty());
+        while (!expected_shards[other_shard].empty()) {
+          expected_shards[shard].push(expected_shards[other_shard].top());
+          expected_shards[other_shard].pop();
+        }
+      }
+    } else if ((operation < 3) && !expected_shards[shard].empty()) {
+      EXPECT_EQ(shards[shard].top(), expected_shards[shard].top());
+      shards[shard].pop();
+      expected_shards[shard].pop();
+      --elements_count;
+    } else {
+      const int value = value_dist(gen);
+      shards[shard].push(value);
+      expected_shards[shard].push(value);
+      max_elements_count = std::max(max_elements_count, ++elements_count);
+    }
+    EXPECT_EQ(shards[shard].getSize(), expected_shards[shard].size());
+  }
+  // Released nodes are reused before the pool grows
+  EXPECT_EQ(pool->nodesCount(), max_elements_count);
+  for (std::size_t shard = 0; shard < shards.size(); ++shard) {
+    EXPECT_EQ(shards[shard].getPool(), pool);
+    std::vector<int> expected;
+    while (!expected_shards[shard].empty()) {
+      expected.push_back(expected_shards[shard].top());
+      expected_shards[shard].pop();
+    }
+    EXPECT_EQ(ads::popAll(shards[shard]), expected);
+  }
+}
+
+TEST(PairingHeap, MergeDifferentPools) {
+  IntPairingHeap first_heap;
+  IntPairingHeap second_heap;
+  for (int value = 0; value < 100; ++value) {
+    (value % 3 == 0 ? first_heap : second_heap).push(value);
+  }
+  EXPECT_NE(first_heap.getPool(), second_heap.getPool());
+  first_heap.merge(std::move(second_heap));
+  EXPECT_TRUE(second_heap.empty());
+  EXPECT_EQ(first_heap.getSize(), 100ULL);
+  std::vector<int> expected(100);
+  for (int value = 0; value < 100; ++value) {
+    expected[static_cast<std::size_t>(99 - value)] = value;
+  }
+  EXPECT_EQ(ads::popAll(first_heap), expected);
+  second_heap.push(5);
+  EXPECT_EQ(second_heap.top(), 5);
+}
+
+TEST(PairingHeap, MoveOnlyValues) {
+  ads::PairingHeap<std::unique_ptr<int>, ads::PointeeMoreCompare> heap;
+  for (int value : {5, 1, 8, 3, 9, 2}) {
+    auto pointer = std::make_unique<int>(value);
+    heap.push(std::move(pointer));
+    EXPECT_EQ(pointer, nullptr);
+  }
+  heap.emplace(new int(7));
+  ads::PairingHeap<std::unique_ptr<int>, ads::PointeeMoreCompare> other_heap;
+  other_heap.emplace(new int(4));
+  heap.merge(std::move(other_heap));
+  std::vector<int> values;
+  while (!heap.empty()) {
+    values.push_back(*heap.top());
+    heap.pop();
+  }
+  EXPECT_EQ(values, std::vector<int>({9, 8, 7, 5, 4, 3, 2, 1}));
+}
+
+TEST(PairingHeap, CopyAndMove) {
+  ads::PairingHeap<std::string, ads::MoreCompare<std::string>> heap;
+  for (const char letter : {'d', 'a', 'c', 'b'}) {
+    heap.push(std::string(20, letter));
+  }
+  heap.push(heap.top());
+  heap.pop();
+  ads::PairingHeap<std::string, ads::MoreCompare<std::string>> copied_heap(
+      heap);
+  EXPECT_EQ(copied_heap.getPool(), heap.getPool());
+  heap.pop();
+  EXPECT_EQ(copied_heap.getSize(), 4ULL);
+  EXPECT_EQ(copied_heap.top(), std::string(20, 'd'));
+  ads::PairingHeap<std::string, ads::MoreCompare<std::string>> moved_heap(
+      std::move(copied_heap));
+  EXPECT_EQ(moved_heap.getSize(), 4ULL);
+  EXPECT_TRUE(copied_heap.empty());
+  copied_heap = heap;
+  EXPECT_EQ(copied_heap.top(), std::string(20, 'c'));
+  moved_heap = std::move(copied_heap);
+  EXPECT_EQ(moved_heap.getSize(), 3ULL);
+  EXPECT_EQ(moved_heap.top(), std::string(20, 'c'));
+  moved_heap.pop();
+  EXPECT_EQ(heap.top(), std::string(20, 'c'));
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/persistent_segment_tree/persistent_segment_tree.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+
+using SumPersistentSegmentTree =
+    ads::PersistentSegmentTree<int, ads::Sum<int>, 0>;
+
+TEST(PersistentSegmentTree, QueryVersions) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  SumPersistentSegmentTree segment_tree(vec);
+  const std::size_t first_version = segment_tree.indexUpdate(0, 0, 10);
+  const std::size_t second_version =
+      segment_tree.indexUpdate(first_version, 1, 7);
+  const std::size_t branch_version = segment_tree.indexUpdate(0, 4, 0);
+  EXPECT_EQ(segment_tree.versionsCount(), 4ULL);
+  EXPECT_EQ(segment_tree.segmentQuery(0, 0ULL, 2ULL), 6);
+  EXPECT_EQ(segment_tree.segmentQuery(first_version, 0ULL, 2ULL), 15);
+  EXPECT_EQ(segment_tree.segmentQuery(second_version, 0ULL, 2ULL), 20);
+  EXPECT_EQ(segment_tree.segmentQuery(branch_version, 0ULL, 4ULL), 13);
+  EXPECT_EQ(segment_tree.segmentQuery(second_version, 2ULL, 4ULL), 20);
+}
+
+TEST(PersistentSegmentTree, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW((SumPersistentSegmentTree(empty_vec)), std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  SumPersistentSegmentTree segment_tree(vec);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(0, 8ULL, 3ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(0, 2ULL, 7ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(1, 0ULL, 1ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.indexUpdate(0, 5ULL, 8)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.indexUpdate(3, 0ULL, 8)),
+               std::range_error);
+  segment_tree.indexUpdate(0, 0ULL, 8);
+  segment_tree.compact({1});
+  EXPECT_FALSE(segment_tree.hasVersion(0));
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(0, 0ULL, 1ULL)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.compact({0}), std::range_error);
+}
+
+TEST(PersistentSegmentTree, SameAsSnapshots) {
+  std::mt19937 gen(39);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  const std::size_t vec_size = 37;
+  std::vector<int> vec(vec_size);
+  for (int& value : vec) {
+    value = value_dist(gen);
+  }
+  SumPersistentSegmentTree segment_tree(vec);
+  std::vector<std::vector<int>> snapshots = {vec};
+  const auto expect_same_as_snapshot = [&](const std::size_t version) {
+    for (std::size_t left = 0; left < vec_size; left += 3) {
+      for (std::size_t right = left; right < vec_size; right += 5) {
+        int expected = 0;
+        for (std::size_t i = left; i <= right; ++i) {
+          expected += snapshots[version][i];
+        }
+        EXPECT_EQ(segment_tree.segmentQuery(version, left, right), expected);
+      }
+    }
+  };
+  for (std::size_t step = 0; step < 300; ++step) {
+    const std::size_t version = gen() % snapshots.size();
+    const std::size_t vec_ind = gen() % vec_size;
+    const int value = value_dist(gen);
+    EXPECT_EQ(segment_tree.indexUpdate(version, vec_ind, value),
+              snapshots.size());
+    snapshots.push_back(snapshots[version]);
+    snapshots.back()[vec_ind] = value;
+  }
+  for (std::size_t version = 0; version < snapshots.size(); ++version) {
+    expect_same_as_snapshot(version);
+  }
+  const std::size_t nodes_count = segment_tree.nodesCount();
+  std::vector<std::size_t> kept_versions;
+  for (std::size_t version = 0; version < snapshots.size(); version += 10) {
+    kept_versions.push_back(version);
+  }
+  segment_tree.compact(kept_versions);
+  EXPECT_LT(segment_tree.nodesCount(), nodes_count);
+  for (const std::size_t version : kept_versions) {
+    expect_same_as_snapshot(version);
+  }
+  const std::size_t new_version =
+      segment_tree.indexUpdate(kept_versions.back(), 0, 5);
+  snapshots.push_back(snapshots[kept_versions.back()]);
+  snapshots.back()[0] = 5;
+  expect_same_as_snapshot(new_version);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/radix_heap/radix_heap.hpp"
+
+// Pushes keys not less than the last popped one, like Dijkstra does
+template <typename T>
+void expectSameAsPriorityQueue(const std::uint32_t seed,
+                               const std::uint64_t max_step) {
+  std::mt19937_64 gen(seed);
+  ads::RadixHeap<T> heap;
+  std::priority_queue<T, std::vector<T>, std::greater<T>> expected_heap;
+  T last_popped = 0;
+  for (std::size_t step = 0; step < 20000; ++step) {
+    if ((gen() % 2 == 0) && !expected_heap.empty()) {
+      EXPECT_EQ(heap.top(), expected_heap.top());
+      last_popped = expected_heap.top();
+      heap.pop();
+      expected_heap.pop();
+    } else {
+      const std::uint64_t room = std::numeric_limits<T>::max() - last_popped;
+      const auto value = static_cast<T>(
+          last_popped + std::min(gen() % (max_step + 1), room));
+      heap.push(value);
+      expected_heap.push(value);
+    }
+    EXPECT_EQ(heap.getSize(), expected_heap.size());
+  }
+  while (!expected_heap.empty()) {
+    EXPECT_EQ(heap.top(), expected_heap.top());
+    heap.pop();
+    expected_heap.pop();
+  }
+  EXPECT_TRUE(heap.empty());
+}
+
+TEST(RadixHeap, SameAsPriorityQueue) {
+  expectSameAsPriorityQueue<std::uint64_t>(49, 1000);
+  expectSameAsPriorityQueue<std::uint64_t>(50, 1ULL << 40);
+  expectSameAsPriorityQueue<std::uint32_t>(51, 3);
+  expectSameAsPriorityQueue<std::uint8_t>(52, 5);
+}
+
+TEST(RadixHeap, ThrowError) {
+  ads::RadixHeap<std::uint32_t> heap;
+  EXPECT_THROW(static_cast<void>(heap.top()), std::length_error);
+  EXPECT_THROW(heap.pop(), std::length_error);
+  heap.push(10);
+  heap.push(20);
+  heap.pop();
+  EXPECT_THROW(heap.push(9), std::invalid_argument);
+  EXPECT_EQ(heap.getSize(), 1ULL);
+  // Keys between the last popped key and the top are allowed
+  heap.push(10);
+  heap.push(15);
+  EXPECT_EQ(heap.top(), 10U);
+  heap.pop();
+  heap.pop();
+  EXPECT_EQ(heap.top(), 20U);
+  heap.pop();
+  EXPECT_THROW(heap.pop(), std::length_error);
+}
+
+TEST(RadixHeap, ExtremeKeys) {
+  const std::uint64_t max_key = std::numeric_limits<std::uint64_t>::max();
+  ads::RadixHeap<std::uint64_t> heap;
+  heap.push(max_key);
+  heap.push(0);
+  heap.push(max_key - 1);
+  heap.push(0);
+  heap.push(1ULL << 63);
+  const std::vector<std::uint64_t> expected = {0, 0, 1ULL << 63, max_key - 1,
+                                               max_key};
+  std::vector<std::uint64_t> values;
+  while (!heap.empty()) {
+    values.push_back(heap.top());
+    heap.pop();
+  }
+  EXPECT_EQ(values, expected);
+  heap.push(max_key);
+  EXPECT_EQ(heap.top(), max_key);
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
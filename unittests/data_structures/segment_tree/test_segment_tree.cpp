@@ -1,5 +1,10 @@
 #include <algorithm>
 #include <limits>
+#include <list>
+#include <random>
+#include <ranges>
+#include <span>
+#include <utility>
 
 #include <gtest/gtest.h>
 
@@ -86,6 +91,184 @@ TEST(SegmentTree, MinOperator) {
   EXPECT_EQ(segment_tree.segmentQuery(7ULL, vec_size - 1), -50);
 }
 
+TEST(SegmentTree, CreateFromRanges) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  const std::span<const int> span(vec);
+  ads::SegmentTree<int, Sum<int>, 0> span_tree(span);
+  EXPECT_EQ(span_tree.segmentQuery(1ULL, 3ULL), 12);
+  std::list<int> list(vec.begin(), vec.end());
+  ads::SegmentTree<int, Sum<int>, 0> list_tree(list);
+  EXPECT_EQ(list_tree.segmentQuery(0ULL, 4ULL), 23);
+  ads::SegmentTree<int, Max<int>, std::numeric_limits<int>::min()> iota_tree(
+      std::views::iota(0, 100) |
+      std::views::transform([](const int value) { return value % 17; }));
+  EXPECT_EQ(iota_tree.segmentQuery(0ULL, 99ULL), 16);
+  EXPECT_EQ(iota_tree.segmentQuery(34ULL, 40ULL), 6);
+  std::vector<int> moved_vec = vec;
+  ads::SegmentTree<int, Sum<int>, 0> moved_tree(std::move(moved_vec));
+  EXPECT_EQ(moved_tree.segmentQuery(2ULL, 4ULL), 20);
+  EXPECT_THROW((ads::SegmentTree<int, Sum<int>, 0>(std::list<int>())),
+               std::runtime_error);
+  EXPECT_THROW((ads::SegmentTree<int, Sum<int>, 0>(std::vector<int>())),
+               std::runtime_error);
+}
+
+TEST(SegmentTree, ParallelBuild) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  // Threads get subtrees of at least 2^16 elements, only the last size is
+  // split
+  for (const std::size_t vec_size :
+       {2047ULL, 4096ULL, 100'003ULL, 300'007ULL}) {
+    std::vector<int> vec(vec_size);
+    for (int& value : vec) {
+      value = value_dist(gen);
+    }
+    const ads::SegmentTree<int, Sum<int>, 0> expected_tree(vec, 1);
+    const std::list<int> list(vec.begin(), vec.end());
+    for (const std::size_t threads_count : {2ULL, 3ULL, 8ULL}) {
+      const ads::SegmentTree<int, Sum<int>, 0> segment_tree(vec,
+                                                            threads_count);
+      const ads::SegmentTree<int, Sum<int>, 0> list_tree(list, threads_count);
+      for (std::size_t step = 0; step < 1000; ++step) {
+        std::size_t left = gen() % vec_size;
+        std::size_t right = gen() % vec_size;
+        if (left > right) {
+          std::swap(left, right);
+        }
+        EXPECT_EQ(segment_tree.segmentQuery(left, right),
+                  expected_tree.segmentQuery(left, right));
+        EXPECT_EQ(list_tree.segmentQuery(left, right),
+                  expected_tree.segmentQuery(left, right));
+      }
+    }
+  }
+}
+
+TEST(SegmentTree, TreeDescent) {
+  std::vector<int> vec = {3, 1, 4, 1, 5, 9, 2, 6};
+  ads::SegmentTree<int, Sum<int>, 0> segment_tree(vec);
+  const auto sum_at_most = [](const int budget) {
+    return [budget](const int sum) { return sum <= budget; };
+  };
+  EXPECT_EQ(segment_tree.maxRight(0ULL, sum_at_most(8)), 3ULL);
+  EXPECT_EQ(segment_tree.maxRight(0ULL, sum_at_most(9)), 4ULL);
+  EXPECT_EQ(segment_tree.maxRight(2ULL, sum_at_most(3)), 2ULL);
+  EXPECT_EQ(segment_tree.maxRight(5ULL, sum_at_most(100)), 8ULL);
+  EXPECT_EQ(segment_tree.maxRight(8ULL, sum_at_most(0)), 8ULL);
+  EXPECT_EQ(segment_tree.minLeft(7ULL, sum_at_most(8)), 6ULL);
+  EXPECT_EQ(segment_tree.minLeft(7ULL, sum_at_most(5)), 8ULL);
+  EXPECT_EQ(segment_tree.minLeft(3ULL, sum_at_most(100)), 0ULL);
+  EXPECT_THROW(static_cast<void>(segment_tree.maxRight(9ULL, sum_at_most(1))),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.minLeft(8ULL, sum_at_most(1))),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.maxRight(0ULL, sum_at_most(-1))),
+               std::invalid_argument);
+}
+
+TEST(SegmentTree, TreeDescentSameAsNaive) {
+  std::mt19937 gen(38);
+  std::uniform_int_distribution<int> value_dist(0, 20);
+  for (std::size_t vec_size = 1; vec_size <= 40; ++vec_size) {
+    std::vector<int> vec(vec_size);
+    for (int& value : vec) {
+      value = value_dist(gen);
+    }
+    ads::SegmentTree<int, Max<int>, std::numeric_limits<int>::min()>
+        segment_tree(vec);
+    for (int threshold = 0; threshold <= 20; threshold += 4) {
+      const auto is_below = [threshold](const int max) {
+        return max < threshold;
+      };
+      for (std::size_t left = 0; left <= vec_size; ++left) {
+        std::size_t expected = left;
+        while ((expected < vec_size) && (vec[expected] < threshold)) {
+          ++expected;
+        }
+        EXPECT_EQ(segment_tree.maxRight(left, is_below), expected);
+      }
+      for (std::size_t right = 0; right < vec_size; ++right) {
+        std::size_t expected = right + 1;
+        while ((expected > 0) && (vec[expected - 1] < threshold)) {
+          --expected;
+        }
+        EXPECT_EQ(segment_tree.minLeft(right, is_below), expected);
+      }
+    }
+  }
+}
+
+TEST(SegmentTree, BatchQueries) {
+  std::mt19937 gen(41);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  const std::size_t vec_size = 5000;
+  std::vector<int> vec(vec_size);
+  for (int& value : vec) {
+    value = value_dist(gen);
+  }
+  ads::SegmentTree<int, Sum<int>, 0> segment_tree(vec);
+  std::vector<std::pair<std::size_t, std::size_t>> queries(20000);
+  for (auto& [left, right] : queries) {
+    left = gen() % vec_size;
+    right = gen() % vec_size;
+    if (left > right) {
+      std::swap(left, right);
+    }
+  }
+  for (const std::size_t threads_count : {1ULL, 4ULL}) {
+    std::vector<int> answers(queries.size());
+    segment_tree.segmentQueries(queries, answers, threads_count);
+    for (std::size_t ind = 0; ind < queries.size(); ++ind) {
+      EXPECT_EQ(answers[ind], segment_tree.segmentQuery(queries[ind].first,
+                                                        queries[ind].second));
+    }
+  }
+  std::vector<int> short_answers(1);
+  EXPECT_THROW(segment_tree.segmentQueries(queries, short_answers),
+               std::invalid_argument);
+  std::vector<std::pair<std::size_t, std::size_t>> bad_queries = {{3, 2}};
+  EXPECT_THROW(segment_tree.segmentQueries(bad_queries, short_answers),
+               std::range_error);
+  bad_queries = {{2, vec_size}};
+  EXPECT_THROW(segment_tree.segmentQueries(bad_queries, short_answers),
+               std::range_error);
+}
+
+TEST(SegmentTree, BatchUpdates) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  const std::size_t vec_size = 5000;
+  std::vector<int> vec(vec_size);
+  for (int& value : vec) {
+    value = value_dist(gen);
+  }
+  for (const std::size_t threads_count : {1ULL, 4ULL}) {
+    ads::SegmentTree<int, Sum<int>, 0> segment_tree(vec);
+    ads::SegmentTree<int, Sum<int>, 0> expected_tree(vec);
+    for (const std::size_t updates_count : {0ULL, 1ULL, 100ULL, 8000ULL}) {
+      std::vector<std::pair<std::size_t, int>> updates(updates_count);
+      for (auto& [vec_ind, value] : updates) {
+        vec_ind = gen() % vec_size;
+        value = value_dist(gen);
+        expected_tree.indexUpdate(vec_ind, value);
+      }
+      segment_tree.applyUpdates(updates, threads_count);
+      for (std::size_t left = 0; left < vec_size; left += 97) {
+        for (std::size_t right = left; right < vec_size; right += 331) {
+          EXPECT_EQ(segment_tree.segmentQuery(left, right),
+                    expected_tree.segmentQuery(left, right));
+        }
+      }
+    }
+  }
+  ads::SegmentTree<int, Sum<int>, 0> segment_tree(vec);
+  std::vector<std::pair<std::size_t, int>> bad_updates = {{1, 5},
+                                                          {vec_size, 1}};
+  EXPECT_THROW(segment_tree.applyUpdates(bad_updates), std::range_error);
+  EXPECT_EQ(segment_tree.segmentQuery(1, 1), vec[1]);
+}
+
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
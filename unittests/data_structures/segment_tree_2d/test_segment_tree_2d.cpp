@@ -0,0 +1,107 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree_2d/segment_tree_2d.hpp"
+
+TEST(SegmentTree2D, CreateTree) {
+  std::vector<std::vector<int>> matrix = {
+      {1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {10, 11, 12}, {13, 14, 15}};
+  ads::SegmentTree2D<int, ads::Sum<int>, 0> segment_tree(matrix);
+  EXPECT_EQ(segment_tree.rowsCount(), 5ULL);
+  EXPECT_EQ(segment_tree.columnsCount(), 3ULL);
+  EXPECT_EQ(segment_tree.rectangleQuery(0ULL, 4ULL, 0ULL, 2ULL), 120);
+  EXPECT_EQ(segment_tree.rectangleQuery(1ULL, 2ULL, 1ULL, 2ULL), 28);
+  EXPECT_EQ(segment_tree.rectangleQuery(4ULL, 4ULL, 0ULL, 0ULL), 13);
+  EXPECT_EQ(segment_tree.rectangleQuery(0ULL, 4ULL, 1ULL, 1ULL), 40);
+  segment_tree.indexUpdate(2ULL, 1ULL, -8);
+  EXPECT_EQ(segment_tree.rectangleQuery(0ULL, 4ULL, 0ULL, 2ULL), 104);
+  EXPECT_EQ(segment_tree.rectangleQuery(1ULL, 2ULL, 1ULL, 2ULL), 12);
+  EXPECT_EQ(segment_tree.rectangleQuery(0ULL, 1ULL, 0ULL, 2ULL), 21);
+}
+
+TEST(SegmentTree2D, ThrowError) {
+  std::vector<std::vector<int>> empty_matrix;
+  EXPECT_THROW((ads::SegmentTree2D<int, ads::Sum<int>, 0>(empty_matrix)),
+               std::runtime_error);
+  std::vector<std::vector<int>> empty_rows(3);
+  EXPECT_THROW((ads::SegmentTree2D<int, ads::Sum<int>, 0>(empty_rows)),
+               std::runtime_error);
+  std::vector<std::vector<int>> ragged_matrix = {{1, 2}, {3}};
+  EXPECT_THROW((ads::SegmentTree2D<int, ads::Sum<int>, 0>(ragged_matrix)),
+               std::invalid_argument);
+  std::vector<std::vector<int>> matrix = {{1, 2, 3}, {4, 5, 6}};
+  ads::SegmentTree2D<int, ads::Sum<int>, 0> segment_tree(matrix);
+  EXPECT_THROW(
+      static_cast<void>(segment_tree.rectangleQuery(1ULL, 0ULL, 0ULL, 1ULL)),
+      std::range_error);
+  EXPECT_THROW(
+      static_cast<void>(segment_tree.rectangleQuery(0ULL, 1ULL, 2ULL, 1ULL)),
+      std::range_error);
+  EXPECT_THROW(
+      static_cast<void>(segment_tree.rectangleQuery(0ULL, 2ULL, 0ULL, 1ULL)),
+      std::range_error);
+  EXPECT_THROW(
+      static_cast<void>(segment_tree.rectangleQuery(0ULL, 1ULL, 0ULL, 3ULL)),
+      std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(2ULL, 0ULL, 1), std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(0ULL, 3ULL, 1), std::range_error);
+}
+
+TEST(SegmentTree2D, SameAsNaive) {
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  for (std::size_t rows_count = 1; rows_count <= 9; rows_count += 2) {
+    for (std::size_t columns_count = 1; columns_count <= 12;
+         columns_count += 3) {
+      std::vector<std::vector<int>> matrix(rows_count,
+                                           std::vector<int>(columns_count));
+      for (auto& row : matrix) {
+        for (int& value : row) {
+          value = value_dist(gen);
+        }
+      }
+      ads::SegmentTree2D<int, ads::Sum<int>, 0> sum_tree(matrix);
+      ads::SegmentTree2D<int, ads::Max<int>, std::numeric_limits<int>::min()>
+          max_tree(matrix);
+      for (std::size_t step = 0; step < 200; ++step) {
+        const std::size_t row = gen() % rows_count;
+        const std::size_t column = gen() % columns_count;
+        const int value = value_dist(gen);
+        matrix[row][column] = value;
+        sum_tree.indexUpdate(row, column, value);
+        max_tree.indexUpdate(row, column, value);
+        std::size_t top = gen() % rows_count;
+        std::size_t bottom = gen() % rows_count;
+        std::size_t left = gen() % columns_count;
+        std::size_t right = gen() % columns_count;
+        if (top > bottom) {
+          std::swap(top, bottom);
+        }
+        if (left > right) {
+          std::swap(left, right);
+        }
+        int expected_sum = 0;
+        int expected_max = std::numeric_limits<int>::min();
+        for (std::size_t i = top; i <= bottom; ++i) {
+          for (std::size_t j = left; j <= right; ++j) {
+            expected_sum += matrix[i][j];
+            expected_max = std::max(expected_max, matrix[i][j]);
+          }
+        }
+        EXPECT_EQ(sum_tree.rectangleQuery(top, bottom, left, right),
+                  expected_sum);
+        EXPECT_EQ(max_tree.rectangleQuery(top, bottom, left, right),
+                  expected_max);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
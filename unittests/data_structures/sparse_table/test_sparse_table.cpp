@@ -0,0 +1,104 @@
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "affine.hpp"
+#include "data_structures/segment_tree/operators.hpp"
+#include "data_structures/segment_tree/segment_tree.hpp"
+#include "data_structures/sparse_table/disjoint_sparse_table.hpp"
+#include "data_structures/sparse_table/sparse_table.hpp"
+
+template <typename T>
+struct Gcd {
+  static constexpr bool kIsIdempotent = true;
+
+  T operator()(const T& left, const T& right) const noexcept {
+    return std::gcd(left, right);
+  }
+};
+
+static_assert(ads::IsIdempotent<ads::Min<int>>::value);
+static_assert(ads::IsIdempotent<Gcd<int>>::value);
+static_assert(!ads::IsIdempotent<ads::Sum<int>>::value);
+static_assert(!ads::IsIdempotent<ads::Compose>::value);
+
+TEST(SparseTable, CreateTable) {
+  std::vector<int> vec = {-4, -10, 15, 25, 6, 2, 3, 7, 10, 0, -45};
+  ads::SparseTable<int, ads::Max<int>> sparse_table(vec);
+  EXPECT_EQ(sparse_table.segmentQuery(0ULL, 10ULL), 25);
+  EXPECT_EQ(sparse_table.segmentQuery(8ULL, 10ULL), 10);
+  EXPECT_EQ(sparse_table.segmentQuery(4ULL, 7ULL), 7);
+  EXPECT_EQ(sparse_table.segmentQuery(10ULL, 10ULL), -45);
+  ads::SparseTable<int, Gcd<int>> gcd_table({12, 18, 27, 9, 6});
+  EXPECT_EQ(gcd_table.segmentQuery(0ULL, 1ULL), 6);
+  EXPECT_EQ(gcd_table.segmentQuery(1ULL, 3ULL), 9);
+  EXPECT_EQ(gcd_table.segmentQuery(0ULL, 4ULL), 3);
+}
+
+TEST(SparseTable, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW((ads::SparseTable<int, ads::Min<int>>(empty_vec)),
+               std::runtime_error);
+  EXPECT_THROW((ads::DisjointSparseTable<int, ads::Sum<int>>(empty_vec)),
+               std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::SparseTable<int, ads::Min<int>> sparse_table(vec);
+  EXPECT_THROW(static_cast<void>(sparse_table.segmentQuery(3ULL, 2ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(sparse_table.segmentQuery(2ULL, 5ULL)),
+               std::range_error);
+  ads::DisjointSparseTable<int, ads::Sum<int>> disjoint_table(vec);
+  EXPECT_THROW(static_cast<void>(disjoint_table.segmentQuery(3ULL, 2ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(disjoint_table.segmentQuery(2ULL, 5ULL)),
+               std::range_error);
+}
+
+TEST(SparseTable, SameAsSegmentTree) {
+  std::mt19937 gen(37);
+  std::uniform_int_distribution<int> value_dist(-1000, 1000);
+  for (std::size_t vec_size = 1; vec_size <= 70; ++vec_size) {
+    std::vector<int> vec(vec_size);
+    for (int& value : vec) {
+      value = value_dist(gen);
+    }
+    ads::SparseTable<int, ads::Min<int>> sparse_table(vec);
+    ads::SegmentTree<int, ads::Min<int>, std::numeric_limits<int>::max()>
+        segment_tree(vec);
+    for (std::size_t left = 0; left < vec_size; ++left) {
+      for (std::size_t right = left; right < vec_size; ++right) {
+        EXPECT_EQ(sparse_table.segmentQuery(left, right),
+                  segment_tree.segmentQuery(left, right));
+      }
+    }
+  }
+}
+
+TEST(DisjointSparseTable, NonCommutativeOperator) {
+  std::mt19937 gen(38);
+  std::uniform_int_distribution<std::int64_t> value_dist(0, 1000);
+  for (std::size_t vec_size = 1; vec_size <= 70; ++vec_size) {
+    std::vector<ads::Affine> vec(vec_size);
+    for (ads::Affine& value : vec) {
+      value = ads::Affine{.mul_ = value_dist(gen), .add_ = value_dist(gen)};
+    }
+    ads::DisjointSparseTable<ads::Affine, ads::Compose> disjoint_table(vec);
+    for (std::size_t left = 0; left < vec_size; ++left) {
+      ads::Affine expected = vec[left];
+      for (std::size_t right = left; right < vec_size; ++right) {
+        if (right > left) {
+          expected = ads::Compose()(expected, vec[right]);
+        }
+        EXPECT_EQ(disjoint_table.segmentQuery(left, right), expected);
+      }
+    }
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include "affine.hpp"
+#include "data_structures/wide_segment_tree/wide_segment_tree.hpp"
+
+// Applies random updates to the tree and a copy of vec, compares every query
+// with a fold of the copy
+template <typename T, typename Functor, T kNeutralElement, typename Generator>
+void expectSameAsNaive(std::vector<T> vec, Generator&& generate_value,
+                       std::mt19937& gen) {
+  ads::WideSegmentTree<T, Functor, kNeutralElement> segment_tree(vec);
+  const Functor bin_operation;
+  for (std::size_t step = 0; step < 300; ++step) {
+    const std::size_t vec_ind = gen() % vec.size();
+    vec[vec_ind] = generate_value();
+    segment_tree.indexUpdate(vec_ind, vec[vec_ind]);
+    std::size_t left = gen() % vec.size();
+    std::size_t right = gen() % vec.size();
+    if (left > right) {
+      std::swap(left, right);
+    }
+    T expected = kNeutralElement;
+    for (std::size_t i = left; i <= right; ++i) {
+      expected = bin_operation(expected, vec[i]);
+    }
+    EXPECT_EQ(segment_tree.segmentQuery(left, right), expected);
+  }
+}
+
+TEST(WideSegmentTree, CreateTree) {
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::WideSegmentTree<int, ads::Sum<int>, 0> segment_tree(vec);
+  EXPECT_EQ(3, segment_tree.segmentQuery(0ULL, 1ULL));
+  EXPECT_EQ(20, segment_tree.segmentQuery(2ULL, 4ULL));
+  segment_tree.indexUpdate(0ULL, 10);
+  segment_tree.indexUpdate(1ULL, 7);
+  EXPECT_EQ(20, segment_tree.segmentQuery(0ULL, 2ULL));
+}
+
+TEST(WideSegmentTree, ThrowError) {
+  std::vector<int> empty_vec;
+  EXPECT_THROW((ads::WideSegmentTree<int, ads::Sum<int>, 0>(empty_vec)),
+               std::runtime_error);
+  std::vector<int> vec = {1, 2, 3, 7, 10};
+  ads::WideSegmentTree<int, ads::Sum<int>, 0> segment_tree(vec);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(8ULL, 3ULL)),
+               std::range_error);
+  EXPECT_THROW(static_cast<void>(segment_tree.segmentQuery(2ULL, 7ULL)),
+               std::range_error);
+  EXPECT_THROW(segment_tree.indexUpdate(5ULL, 8), std::range_error);
+}
+
+TEST(WideSegmentTree, SameAsNaive) {
+  std::mt19937 gen(35);
+  std::uniform_int_distribution<int> int_dist(-1000, 1000);
+  const auto random_int = [&]() { return int_dist(gen); };
+  const auto random_int64 = [&]() {
+    return static_cast<std::int64_t>(int_dist(gen));
+  };
+  // Small integers are summed exactly in any order
+  const auto random_double = [&]() {
+    return static_cast<double>(int_dist(gen));
+  };
+  const auto random_affine = [&]() {
+    return ads::Affine{.mul_ = int_dist(gen) + 1000,
+                       .add_ = int_dist(gen) + 1000};
+  };
+  for (const std::size_t vec_size :
+       {1ULL, 2ULL, 8ULL, 9ULL, 16ULL, 17ULL, 100ULL, 256ULL, 300ULL,
+        5000ULL}) {
+    std::vector<int> int_vec(vec_size);
+    std::generate(int_vec.begin(), int_vec.end(), random_int);
+    expectSameAsNaive<int, ads::Sum<int>, 0>(int_vec, random_int, gen);
+    expectSameAsNaive<int, ads::Min<int>, std::numeric_limits<int>::max()>(
+        int_vec, random_int, gen);
+    expectSameAsNaive<int, ads::Max<int>, std::numeric_limits<int>::min()>(
+        int_vec, random_int, gen);
+    std::vector<std::int64_t> int64_vec(vec_size);
+    std::generate(int64_vec.begin(), int64_vec.end(), random_int64);
+    expectSameAsNaive<std::int64_t, std::plus<std::int64_t>, 0>(
+        int64_vec, random_int64, gen);
+    std::vector<double> double_vec(vec_size);
+    std::generate(double_vec.begin(), double_vec.end(), random_double);
+    expectSameAsNaive<double, ads::Sum<double>, 0.0>(double_vec, random_double,
+                                                    gen);
+    expectSameAsNaive<double, ads::Max<double>,
+                      -std::numeric_limits<double>::infinity()>(
+        double_vec, random_double, gen);
+    std::vector<ads::Affine> affine_vec(vec_size);
+    std::generate(affine_vec.begin(), affine_vec.end(), random_affine);
+    expectSameAsNaive<ads::Affine, ads::Compose,
+                      ads::Affine{.mul_ = 1, .add_ = 0}>(affine_vec,
+                                                         random_affine, gen);
+  }
+}
+
+// Sums of 8 and 16 bit lanes overflow, they must wrap like the promoted
+// scalar sum
+TEST(WideSegmentTree, SmallIntegerSumOverflow) {
+  std::mt19937 gen(350);
+  std::uniform_int_distribution<int> int8_dist(
+      std::numeric_limits<std::int8_t>::min(),
+      std::numeric_limits<std::int8_t>::max());
+  std::uniform_int_distribution<int> int16_dist(
+      std::numeric_limits<std::int16_t>::min(),
+      std::numeric_limits<std::int16_t>::max());
+  const auto random_int8 = [&]() {
+    return static_cast<std::int8_t>(int8_dist(gen));
+  };
+  const auto random_int16 = [&]() {
+    return static_cast<std::int16_t>(int16_dist(gen));
+  };
+  for (const std::size_t vec_size : {17ULL, 300ULL, 5000ULL}) {
+    std::vector<std::int8_t> int8_vec(vec_size);
+    std::generate(int8_vec.begin(), int8_vec.end(), random_int8);
+    expectSameAsNaive<std::int8_t, ads::Sum<std::int8_t>, 0>(
+        int8_vec, random_int8, gen);
+    std::vector<std::int16_t> int16_vec(vec_size);
+    std::generate(int16_vec.begin(), int16_vec.end(), random_int16);
+    expectSameAsNaive<std::int16_t, ads::Sum<std::int16_t>, 0>(
+        int16_vec, random_int16, gen);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,30 @@
+#ifndef CUSTOMADS_SRC_UNITTESTS_HEAP_HELPERS_HPP_
+#define CUSTOMADS_SRC_UNITTESTS_HEAP_HELPERS_HPP_
+
+#include <memory>
+#include <vector>
+
+namespace ads {
+
+// Max-heap order of the pointed values
+struct PointeeMoreCompare {
+  bool operator()(const std::unique_ptr<int>& left,
+                  const std::unique_ptr<int>& right) const noexcept {
+    return *left > *right;
+  }
+};
+
+// Pops every element of the heap, returns them in the order of popping
+template <typename HeapType>
+std::vector<typename HeapType::value_type> popAll(HeapType& heap) {
+  std::vector<typename HeapType::value_type> values;
+  while (!heap.empty()) {
+    values.push_back(heap.top());
+    heap.pop();
+  }
+  return values;
+}
+
+}  // namespace ads
+
+#endif  // CUSTOMADS_SRC_UNITTESTS_HEAP_HELPERS_HPP_